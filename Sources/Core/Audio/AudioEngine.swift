@@ -21,9 +21,16 @@ final class AudioEngine {
     }
 
     private func setupSourceNode() {
+        var renderThread: mach_port_t = 0
         sourceNode = AVAudioSourceNode {
             [weak self] _, _, frameCount, audioBufferList -> OSStatus in
             guard let self = self else { return noErr }
+
+            // Report a new render thread; it is tagged and its policy read off this thread
+            let thread = pthread_mach_thread_np(pthread_self())
+            if thread != renderThread, ThreadConfiguration.shared.recordAudioRenderThread(thread) {
+                renderThread = thread
+            }
             let ablPointer = UnsafeMutableAudioBufferListPointer(audioBufferList)
             guard let buffer = ablPointer.first?.mData else {
                 return kAudioUnitErr_InvalidParameter
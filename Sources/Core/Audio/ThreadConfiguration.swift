@@ -0,0 +1,170 @@
+import Darwin
+import Foundation
+
+/// Scheduling of the audio render thread and the simulation workers.
+///
+/// CoreAudio already runs its render thread under the Mach time-constraint policy, with a
+/// period and computation budget matched to the device's I/O cycle, so that policy is left as
+/// it is and only reported. Simulation work runs on the threads of `WorkerPool` at `workerQoS`,
+/// below anything interactive. Where the kernel honours affinity tags (Intel Macs), the render
+/// thread and the workers get different tags, which keeps them on separate L2 caches. Apple
+/// silicon has no user-visible pinning and rejects the tags.
+///
+/// The render callback only records which thread it runs on, behind a try-lock and without
+/// allocating. Reading its policy and tagging it happen later on an ordinary thread, the next
+/// time the status is read or a worker picks up a job. The results are kept in `status` for
+/// the performance report.
+final class ThreadConfiguration {
+    static let shared = ThreadConfiguration()
+
+    struct Status {
+        /// Period of the time-constraint policy CoreAudio gave the render thread, nil while it has none
+        var audioPeriod: Double?
+        /// Why the render thread is reported without a time-constraint policy
+        var audioFallbackReason: String?
+        /// Whether the render thread accepted its affinity tag
+        var audioThreadTagged = false
+        /// Worker threads that accepted or rejected their affinity tag
+        var workerThreadsTagged = 0
+        var workerThreadsUntagged = 0
+
+        /// Whether the render thread and every worker carry their own tags
+        var affinityTagsApplied: Bool {
+            return audioThreadTagged && workerThreadsTagged > 0 && workerThreadsUntagged == 0
+        }
+
+        var description: String {
+            var text: String
+            if let period = audioPeriod {
+                text = "Audio RT: \(String(format: "%.1f ms", period * 1000))"
+            } else {
+                text = "Audio RT: off (\(audioFallbackReason ?? "render thread not started"))"
+            }
+            text += affinityTagsApplied ? " | Affinity: split" : " | Affinity: shared"
+            return text
+        }
+    }
+
+    /// Quality of service of the simulation worker threads
+    let workerQoS: QualityOfService = .utility
+
+    private let audioAffinityTag: integer_t = 1
+    private let workerAffinityTag: integer_t = 2
+
+    /// Guards everything below; the render thread only ever try-locks it
+    private let lock: UnsafeMutablePointer<os_unfair_lock> = {
+        let lock = UnsafeMutablePointer<os_unfair_lock>.allocate(capacity: 1)
+        lock.initialize(to: os_unfair_lock())
+        return lock
+    }()
+    private var currentStatus = Status()
+    private var affinitySupported = true
+    /// Render thread last recorded by the callback, and the one whose configuration is in `status`
+    private var recordedAudioThread: thread_act_t = 0
+    private var configuredAudioThread: thread_act_t = 0
+
+    private init() {}
+
+    /// Current configuration, as shown in the performance report
+    var status: Status {
+        applyPendingAudioThreadConfiguration()
+        os_unfair_lock_lock(lock)
+        defer { os_unfair_lock_unlock(lock) }
+        return currentStatus
+    }
+
+    /// Note the calling thread as the audio render thread.
+    ///
+    /// Safe to call from the render callback: it never blocks or allocates. Call it when the
+    /// callback's thread changes.
+    /// - Returns: Whether the thread was recorded; when false, call again on the next callback
+    func recordAudioRenderThread(_ thread: thread_act_t) -> Bool {
+        guard os_unfair_lock_trylock(lock) else { return false }
+        recordedAudioThread = thread
+        os_unfair_lock_unlock(lock)
+        return true
+    }
+
+    /// Read the policy of a newly recorded render thread and tag it. Runs off the render thread.
+    func applyPendingAudioThreadConfiguration() {
+        os_unfair_lock_lock(lock)
+        let thread = recordedAudioThread
+        let pending = thread != configuredAudioThread
+        configuredAudioThread = thread
+        os_unfair_lock_unlock(lock)
+        guard pending else { return }
+
+        var policy = thread_time_constraint_policy_data_t()
+        var count = policyCount(thread_time_constraint_policy_data_t.self)
+        var isDefault: boolean_t = 0
+        let result = withUnsafeMutablePointer(to: &policy) {
+            $0.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                thread_policy_get(
+                    thread, thread_policy_flavor_t(THREAD_TIME_CONSTRAINT_POLICY), $0, &count, &isDefault)
+            }
+        }
+        let tagged = setAffinityTag(audioAffinityTag, on: thread)
+
+        var timebase = mach_timebase_info_data_t()
+        mach_timebase_info(&timebase)
+        let secondsPerTick = 1e-9 * Double(timebase.numer) / Double(timebase.denom)
+
+        os_unfair_lock_lock(lock)
+        if result != KERN_SUCCESS {
+            currentStatus.audioPeriod = nil
+            currentStatus.audioFallbackReason = String(cString: mach_error_string(result))
+        } else if isDefault != 0 || policy.period == 0 {
+            currentStatus.audioPeriod = nil
+            currentStatus.audioFallbackReason = "no time-constraint policy"
+        } else {
+            currentStatus.audioPeriod = Double(policy.period) * secondsPerTick
+            currentStatus.audioFallbackReason = nil
+        }
+        currentStatus.audioThreadTagged = tagged
+        os_unfair_lock_unlock(lock)
+    }
+
+    /// Configure the calling thread as a simulation worker; `WorkerPool` calls this once per thread
+    func configureWorkerThread() {
+        let tagged = setAffinityTag(workerAffinityTag, on: pthread_mach_thread_np(pthread_self()))
+
+        os_unfair_lock_lock(lock)
+        if tagged {
+            currentStatus.workerThreadsTagged += 1
+        } else {
+            currentStatus.workerThreadsUntagged += 1
+        }
+        os_unfair_lock_unlock(lock)
+    }
+
+    // MARK: - Private Methods
+
+    /// Set an affinity tag, remembering when the kernel does not support them
+    private func setAffinityTag(_ tag: integer_t, on thread: thread_act_t) -> Bool {
+        os_unfair_lock_lock(lock)
+        let supported = affinitySupported
+        os_unfair_lock_unlock(lock)
+        guard supported else { return false }
+
+        var policy = thread_affinity_policy_data_t(affinity_tag: tag)
+        let result = withUnsafeMutablePointer(to: &policy) {
+            $0.withMemoryRebound(to: integer_t.self, capacity: Int(policyCount(thread_affinity_policy_data_t.self))) {
+                thread_policy_set(
+                    thread, thread_policy_flavor_t(THREAD_AFFINITY_POLICY), $0,
+                    policyCount(thread_affinity_policy_data_t.self))
+            }
+        }
+
+        if result == KERN_NOT_SUPPORTED {
+            os_unfair_lock_lock(lock)
+            affinitySupported = false
+            os_unfair_lock_unlock(lock)
+        }
+        return result == KERN_SUCCESS
+    }
+
+    /// Size of a thread policy structure in `integer_t` units
+    private func policyCount<Policy>(_ type: Policy.Type) -> mach_msg_type_number_t {
+        return mach_msg_type_number_t(MemoryLayout<Policy>.size / MemoryLayout<integer_t>.size)
+    }
+}
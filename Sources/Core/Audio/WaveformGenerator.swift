@@ -195,10 +195,17 @@ final class WaveformGenerator {
         mixerNode = AVAudioMixerNode()
 
         // Create source node
+        var renderThread: mach_port_t = 0
         let sourceNode = AVAudioSourceNode {
             [weak self] _, _, frameCount, audioBufferList -> OSStatus in
             guard let self = self else { return noErr }
 
+            // Report a new render thread; it is tagged and its policy read off this thread
+            let thread = pthread_mach_thread_np(pthread_self())
+            if thread != renderThread, ThreadConfiguration.shared.recordAudioRenderThread(thread) {
+                renderThread = thread
+            }
+
             let ablPointer = UnsafeMutableAudioBufferListPointer(audioBufferList)
 
             // Generate audio samples
@@ -0,0 +1,291 @@
+import Accelerate
+import Foundation
+
+/// Alternating-direction implicit (Peaceman–Rachford) Crank–Nicolson propagator for 2D and 3D grids.
+///
+/// Explicit schemes on an n-dimensional grid need dt ≲ m dx²/ħ, which becomes prohibitive
+/// on fine grids. Here each step is a Strang splitting of the potential phase around the
+/// kinetic factor Π_a (1 + iτT_a)⁻¹(1 - iτT_a), one implicit Crank–Nicolson sweep per axis.
+/// On a rectangular box the axis operators T_a commute, so this factorization is the
+/// Peaceman–Rachford ADI step and stays unconditionally stable and exactly unitary, while
+/// every sweep is only a batch of independent tridiagonal solves.
+///
+/// All lines along an axis share one factorization. The solves run with the line index
+/// innermost so they vectorize across lines. Along x, where lines are contiguous, blocks of
+/// lines are transposed into scratch first. Work is spread across cores by planes and line blocks;
+/// the transpose scratch comes from `GridAllocator` once per `propagate` call, one slot per worker.
+/// Boundaries are Dirichlet: ψ vanishes one cell outside every axis grid.
+///
+/// For a potential that is mirror symmetric along some axes and a state of definite parity
+/// along them, only the half x ≥ c of each such axis is stored (a quarter of the box in 2D, an
+/// eighth in 3D). A reduced axis samples c + (j + ½)dx, and the mirror image enters its first
+/// row as a ghost point ψ₋₁ = ±ψ₀, which is the Neumann (even) or Dirichlet (odd) condition at
+/// the mirror. The reduced state holds the values of the full normalized ψ, so `norm(of:)`
+/// weights it by the mirror images, and the full box is rebuilt only on request.
+final class ADIPropagator {
+    /// One grid per axis, x first; the state is stored x-fastest
+    let axes: [QuantumGrid]
+    /// Parity of the state about each reduced axis' mirror point c = xMin - dx/2 (nil for full axes)
+    let parities: [Parity?]
+    let mass: Double
+    /// Potential energy in Joules at every grid point
+    let potential: [Double]
+
+    /// Lines per transposed block when sweeping the contiguous axis
+    var lineBlockSize = 64
+
+    private let hBar = QuantumMath.reducedPlanckConstant
+    private var cachedSteps: (dt: Double, steps: [CrankNicolsonStep])?
+
+    /// Total number of grid points
+    var count: Int {
+        return axes.reduce(1) { $0 * $1.count }
+    }
+
+    /// Volume element Π dx_a
+    var cellVolume: Double {
+        return axes.reduce(1) { $0 * $1.dx }
+    }
+
+    /// Number of full-box points each stored point stands for (2 per reduced axis)
+    var mirrorMultiplicity: Double {
+        return Double(1 << parities.filter { $0 != nil }.count)
+    }
+
+    /// Axis grids of the full box; reduced axes are extended by their mirror image
+    var fullAxes: [QuantumGrid] {
+        return zip(axes, parities).map { axis, parity in
+            guard parity != nil else { return axis }
+            return QuantumGrid(xMin: axis.xMin - (axis.xMax - axis.xMin), xMax: axis.xMax, count: 2 * axis.count)
+        }
+    }
+
+    /// - Parameters:
+    ///   - axes: Two or three axis grids (x, y[, z]); a reduced axis is
+    ///     `QuantumGrid.mirrorReduced(center:halfWidth:count:)`
+    ///   - parities: Parity of the state along each axis whose grid covers only x ≥ c
+    ///     (nil or missing entries are full axes)
+    ///   - mass: Particle mass in kg
+    ///   - potential: Potential V(x, y, z) in Joules (z = 0 on 2D grids); must be mirror
+    ///     symmetric along every reduced axis
+    init(
+        axes: [QuantumGrid], parities: [Parity?] = [], mass: Double,
+        potential: (Double, Double, Double) -> Double
+    ) {
+        precondition(axes.count == 2 || axes.count == 3, "ADI propagator supports 2D and 3D grids")
+        precondition(parities.count <= axes.count, "More parities than axes")
+        self.axes = axes
+        self.parities = parities + [Parity?](repeating: nil, count: axes.count - parities.count)
+        self.mass = mass
+
+        let nx = axes[0].count
+        let ny = axes[1].count
+        let nz = axes.count == 3 ? axes[2].count : 1
+        var samples = [Double](repeating: 0, count: nx * ny * nz)
+        for k in 0..<nz {
+            let z = axes.count == 3 ? axes[2].position(at: k) : 0
+            for j in 0..<ny {
+                let y = axes[1].position(at: j)
+                for i in 0..<nx {
+                    samples[(k * ny + j) * nx + i] = potential(axes[0].position(at: i), y, z)
+                }
+            }
+        }
+        self.potential = samples
+    }
+
+    // MARK: - State Helpers
+
+    /// Sample ψ(x, y, z) on the grid and normalize it over the full box (z = 0 on 2D grids)
+    func makeState(_ function: (Double, Double, Double) -> Complex) -> ComplexArray {
+        let nx = axes[0].count
+        let ny = axes[1].count
+        let nz = axes.count == 3 ? axes[2].count : 1
+
+        var psi = ComplexArray(count: count)
+        for k in 0..<nz {
+            let z = axes.count == 3 ? axes[2].position(at: k) : 0
+            for j in 0..<ny {
+                let y = axes[1].position(at: j)
+                for i in 0..<nx {
+                    psi[(k * ny + j) * nx + i] = function(axes[0].position(at: i), y, z)
+                }
+            }
+        }
+
+        psi.normalize(dx: cellVolume * mirrorMultiplicity)
+        return psi
+    }
+
+    /// ∫|ψ|² dV over the full box
+    func norm(of psi: ComplexArray) -> Double {
+        return psi.norm(dx: cellVolume * mirrorMultiplicity)
+    }
+
+    /// Rebuild ψ on `fullAxes` by mirroring every reduced axis with its parity sign
+    func reconstructWaveFunction(_ psi: ComplexArray) -> ComplexArray {
+        precondition(psi.count == count, "State does not match propagator grid")
+
+        // Source index and sign along each axis for every full-box index
+        let maps = zip(axes, parities).map { axis, parity -> [(index: Int, sign: Double)] in
+            let n = axis.count
+            guard let parity = parity else { return (0..<n).map { ($0, 1) } }
+            return (0..<(2 * n)).map { i in i >= n ? (i - n, 1) : (n - 1 - i, parity.sign) }
+        }
+        let zMap = axes.count == 3 ? maps[2] : [(index: 0, sign: 1.0)]
+        let nx = axes[0].count
+        let ny = axes[1].count
+
+        var full = ComplexArray(count: maps[0].count * maps[1].count * zMap.count)
+        var target = 0
+        for z in zMap {
+            for y in maps[1] {
+                for x in maps[0] {
+                    let source = (z.index * ny + y.index) * nx + x.index
+                    let sign = x.sign * y.sign * z.sign
+                    full.real[target] = sign * psi.real[source]
+                    full.imaginary[target] = sign * psi.imaginary[source]
+                    target += 1
+                }
+            }
+        }
+        return full
+    }
+
+    // MARK: - Propagation
+
+    /// Advance ψ by `steps` ADI steps of size `dt` (any dt is stable)
+    /// - Parameter cancellation: Checked once per step; a cancelled run closes its last step,
+    ///   so ψ is a complete state at an earlier time
+    func propagate(_ psi: inout ComplexArray, timeStep dt: Double, steps: Int, cancellation: CancellationToken? = nil) {
+        guard steps > 0 else { return }
+        precondition(psi.count == count, "State does not match propagator grid")
+
+        let axisSteps = crankNicolsonSteps(dt: dt)
+        let length = vDSP_Length(count)
+
+        // Transpose scratch for the contiguous axis: one block of real and imaginary lines per
+        // worker, fully overwritten before every use
+        let nx = axes[0].count
+        let blockSize = max(1, min(lineBlockSize, count / nx))
+        let workers = WorkerPool.shared.threadCount
+        let scratch = GridBuffer<Double>(count: workers * 2 * blockSize * nx, zeroed: false)
+
+        var halfPotential = FFTPlan.phaseTable(angles: potential.map { -$0 * dt / (2 * hBar) })
+        var fullPotential = FFTPlan.phaseTable(angles: potential.map { -$0 * dt / hBar })
+
+        halfPotential.withSplitComplex { vHalf in
+            fullPotential.withSplitComplex { vFull in
+                psi.withSplitComplex { state in
+                    let re = state.pointee.realp
+                    let im = state.pointee.imagp
+
+                    vDSP_zvmulD(state, 1, vHalf, 1, state, 1, length, 1)
+
+                    for step in 0..<steps {
+                        let isLast = step == steps - 1 || cancellation?.isCancelled == true
+                        for axis in 0..<axes.count {
+                            sweep(
+                                axis: axis, with: axisSteps[axis], real: re, imaginary: im,
+                                scratch: scratch.baseAddress, blockSize: blockSize)
+                        }
+
+                        let potentialStep = isLast ? vHalf : vFull
+                        vDSP_zvmulD(state, 1, potentialStep, 1, state, 1, length, 1)
+                        if isLast {
+                            break
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // MARK: - Private Methods
+
+    /// Apply one axis' Crank–Nicolson factor to every line along that axis
+    /// - Parameters:
+    ///   - scratch: 2 · `blockSize` · n doubles per pool worker, used by the contiguous axis
+    ///   - blockSize: Lines per transposed block
+    private func sweep(
+        axis: Int, with step: CrankNicolsonStep, real: UnsafeMutablePointer<Double>,
+        imaginary: UnsafeMutablePointer<Double>, scratch: UnsafeMutablePointer<Double>, blockSize: Int
+    ) {
+        let n = axes[axis].count
+        let stride = axes[0..<axis].reduce(1) { $0 * $1.count }
+        let total = count
+        let workers = WorkerPool.shared.threadCount
+
+        if stride > 1 {
+            // Lines are interleaved with unit stride: solve them in place as lane-contiguous
+            // batches, splitting each plane into chunks when there are too few planes to go round
+            let planes = total / (stride * n)
+            let chunksPerPlane = max(1, min(stride / 64, (4 * workers) / planes))
+            let chunk = (stride + chunksPerPlane - 1) / chunksPerPlane
+
+            WorkerPool.shared.concurrentPerform(iterations: planes * chunksPerPlane) { item in
+                let laneStart = (item % chunksPerPlane) * chunk
+                let lanes = min(chunk, stride - laneStart)
+                guard lanes > 0 else { return }
+
+                let base = (item / chunksPerPlane) * stride * n + laneStart
+                step.apply(real: real + base, imaginary: imaginary + base, lanes: lanes, lineStride: stride)
+            }
+        } else {
+            // Lines are contiguous: transpose blocks of lines so the solve runs across them.
+            // Each worker takes every workers-th block through its own scratch slot.
+            let lines = total / n
+            let blocks = (lines + blockSize - 1) / blockSize
+            let participants = min(workers, blocks)
+
+            WorkerPool.shared.concurrentPerform(iterations: participants) { worker in
+                let sRe = scratch + worker * 2 * blockSize * n
+                let sIm = sRe + blockSize * n
+
+                var block = worker
+                while block < blocks {
+                    let firstLine = block * blockSize
+                    let lanes = min(blockSize, lines - firstLine)
+                    let base = firstLine * n
+
+                    // lanes × n → n × lanes
+                    vDSP_mtransD(real + base, 1, sRe, 1, vDSP_Length(n), vDSP_Length(lanes))
+                    vDSP_mtransD(imaginary + base, 1, sIm, 1, vDSP_Length(n), vDSP_Length(lanes))
+
+                    step.apply(real: sRe, imaginary: sIm, lanes: lanes, lineStride: lanes)
+
+                    vDSP_mtransD(sRe, 1, real + base, 1, vDSP_Length(lanes), vDSP_Length(n))
+                    vDSP_mtransD(sIm, 1, imaginary + base, 1, vDSP_Length(lanes), vDSP_Length(n))
+                    block += participants
+                }
+            }
+        }
+    }
+
+    /// One factorized Cayley operator per axis for this time step
+    private func crankNicolsonSteps(dt: Double) -> [CrankNicolsonStep] {
+        if let cached = cachedSteps, cached.dt == dt {
+            return cached.steps
+        }
+
+        let kineticScale = hBar * hBar / (2 * mass)
+        let steps = zip(axes, parities).map { axis, parity -> CrankNicolsonStep in
+            let n = axis.count
+            let coupling = kineticScale / (axis.dx * axis.dx)
+
+            // A reduced axis folds its ghost point ψ₋₁ = ±ψ₀ into the first diagonal entry
+            var diagonal = [Double](repeating: 2 * coupling, count: n)
+            if let parity = parity {
+                diagonal[0] -= parity.sign * coupling
+            }
+            return CrankNicolsonStep(
+                weights: [Double](repeating: 1, count: n),
+                diagonal: diagonal,
+                offDiagonal: [Double](repeating: -coupling, count: max(n - 1, 0)),
+                tau: dt / (2 * hBar))
+        }
+
+        cachedSteps = (dt, steps)
+        return steps
+    }
+}
@@ -0,0 +1,221 @@
+import Accelerate
+import Foundation
+
+/// Propagator for cylindrically symmetric problems on a 2D (r, z) grid.
+///
+/// A state ψ(r, z)e^{imφ} in a potential V(r, z) obeys
+/// iħ∂ψ/∂t = -ħ²/2m [1/r ∂/∂r(r ∂ψ/∂r) - m²ψ/r² + ∂²ψ/∂z²] + Vψ.
+/// Radial nodes sit at cell centers r_i = (i + ½)Δr, so the axis is a cell face with zero
+/// flux (r_{-½} = 0) and the 1/r factor is never evaluated on it. Each step is a Strang
+/// splitting of the potential phase with Crank–Nicolson sweeps along r and z; every sweep is
+/// a batch of independent tridiagonal solves that run in parallel across lines and are exactly
+/// unitary in the cylindrical norm 2π Σ r_i Δr Δz |ψ|².
+final class AxisymmetricPropagator {
+    /// Number of radial cells between the axis and `maxRadius`
+    let radialCount: Int
+    let maxRadius: Double
+    /// Axial grid (Dirichlet at both ends; `axialGrid.count` interior points)
+    let axialGrid: QuantumGrid
+    /// Azimuthal quantum number m
+    let azimuthalNumber: Int
+    let mass: Double
+    /// Potential energy V(r, z) in Joules, laid out r-fastest (index = k·radialCount + i)
+    let potential: [Double]
+
+    private let hBar = QuantumMath.reducedPlanckConstant
+    private var cachedSteps: (dt: Double, radial: CrankNicolsonStep, axial: CrankNicolsonStep)?
+
+    /// Radial cell width Δr
+    var dr: Double {
+        return maxRadius / Double(radialCount)
+    }
+
+    /// Radius of radial cell `index`
+    func radius(at index: Int) -> Double {
+        return (Double(index) + 0.5) * dr
+    }
+
+    /// Total number of stored samples
+    var count: Int {
+        return radialCount * axialGrid.count
+    }
+
+    /// - Parameters:
+    ///   - radialCount: Radial cells between the axis and `maxRadius`
+    ///   - maxRadius: Outer (Dirichlet) radius in meters
+    ///   - axialGrid: Axial sample positions
+    ///   - azimuthalNumber: Angular momentum m about the symmetry axis
+    ///   - mass: Particle mass in kg
+    ///   - potential: Potential V(r, z) in Joules
+    init(
+        radialCount: Int, maxRadius: Double, axialGrid: QuantumGrid, azimuthalNumber: Int = 0,
+        mass: Double, potential: (Double, Double) -> Double
+    ) {
+        self.radialCount = radialCount
+        self.maxRadius = maxRadius
+        self.axialGrid = axialGrid
+        self.azimuthalNumber = azimuthalNumber
+        self.mass = mass
+
+        let dr = maxRadius / Double(radialCount)
+        var samples = [Double](repeating: 0, count: radialCount * axialGrid.count)
+        for k in 0..<axialGrid.count {
+            let z = axialGrid.position(at: k)
+            for i in 0..<radialCount {
+                samples[k * radialCount + i] = potential((Double(i) + 0.5) * dr, z)
+            }
+        }
+        self.potential = samples
+    }
+
+    // MARK: - Conversion
+
+    /// Sample ψ(r, z) on the grid and normalize it in the cylindrical measure
+    func makeState(_ function: (Double, Double) -> Complex) -> ComplexArray {
+        var psi = ComplexArray(count: count)
+        for k in 0..<axialGrid.count {
+            let z = axialGrid.position(at: k)
+            for i in 0..<radialCount {
+                psi[k * radialCount + i] = function(radius(at: i), z)
+            }
+        }
+
+        let n = norm(of: psi)
+        if n > 0 {
+            psi.scale(by: 1 / sqrt(n))
+        }
+        return psi
+    }
+
+    /// 2π ∫|ψ|² r dr dz
+    func norm(of psi: ComplexArray) -> Double {
+        let density = psi.probabilityDensity
+        var total = 0.0
+        for i in 0..<radialCount {
+            var column = 0.0
+            density.withUnsafeBufferPointer {
+                vDSP_sveD($0.baseAddress! + i, radialCount, &column, vDSP_Length(axialGrid.count))
+            }
+            total += column * radius(at: i)
+        }
+        return 2 * Double.pi * total * dr * axialGrid.dx
+    }
+
+    /// |ψ|² on a Cartesian volume for rendering: `resolution` points across [-maxRadius, maxRadius]
+    /// in x and y, and `axialGrid.count` planes in z. Values are laid out x-fastest.
+    func densityVolume(_ psi: ComplexArray, resolution: Int) -> [Float] {
+        let density = psi.probabilityDensity
+        let spacing = 2 * maxRadius / Double(max(resolution - 1, 1))
+        let planeSize = resolution * resolution
+        let nr = radialCount
+
+        var volume = [Float](repeating: 0, count: planeSize * axialGrid.count)
+        volume.withUnsafeMutableBufferPointer { output in
+            WorkerPool.shared.concurrentPerform(iterations: axialGrid.count) { k in
+                let row = k * nr
+                for j in 0..<resolution {
+                    let y = -maxRadius + Double(j) * spacing
+                    for i in 0..<resolution {
+                        let x = -maxRadius + Double(i) * spacing
+
+                        // Linear interpolation between cell centers; flat inside the first half cell
+                        let position = sqrt(x * x + y * y) / dr - 0.5
+                        guard position < Double(nr - 1) else { continue }
+                        let lower = max(Int(position.rounded(.down)), 0)
+                        let fraction = max(position - Double(lower), 0)
+                        let value =
+                            (1 - fraction) * density[row + lower] + fraction * density[row + lower + 1]
+                        output[k * planeSize + j * resolution + i] = Float(value)
+                    }
+                }
+            }
+        }
+        return volume
+    }
+
+    // MARK: - Propagation
+
+    /// Advance ψ by `steps` Strang steps of size `dt`
+    func propagate(_ psi: inout ComplexArray, timeStep dt: Double, steps: Int) {
+        guard steps > 0 else { return }
+        precondition(psi.count == count, "State does not match propagator grid")
+
+        let (radialStep, axialStep) = crankNicolsonSteps(dt: dt)
+        let nr = radialCount
+        let nz = axialGrid.count
+        let length = vDSP_Length(count)
+
+        var halfPotential = FFTPlan.phaseTable(angles: potential.map { -$0 * dt / (2 * hBar) })
+        var fullPotential = FFTPlan.phaseTable(angles: potential.map { -$0 * dt / hBar })
+
+        halfPotential.withSplitComplex { vHalf in
+            fullPotential.withSplitComplex { vFull in
+                psi.withSplitComplex { state in
+                    let re = state.pointee.realp
+                    let im = state.pointee.imagp
+
+                    vDSP_zvmulD(state, 1, vHalf, 1, state, 1, length, 1)
+
+                    for step in 0..<steps {
+                        // r-lines are contiguous; z-lines are strided by the radial count
+                        WorkerPool.shared.concurrentPerform(iterations: nz) { k in
+                            radialStep.apply(real: re + k * nr, imaginary: im + k * nr)
+                        }
+                        WorkerPool.shared.concurrentPerform(iterations: nr) { i in
+                            axialStep.apply(real: re + i, imaginary: im + i, stride: nr)
+                        }
+                        WorkerPool.shared.concurrentPerform(iterations: nz) { k in
+                            radialStep.apply(real: re + k * nr, imaginary: im + k * nr)
+                        }
+
+                        let potentialStep = step == steps - 1 ? vHalf : vFull
+                        vDSP_zvmulD(state, 1, potentialStep, 1, state, 1, length, 1)
+                    }
+                }
+            }
+        }
+    }
+
+    // MARK: - Private Methods
+
+    /// Radial half-step and axial full-step Cayley operators for this time step
+    private func crankNicolsonSteps(dt: Double) -> (CrankNicolsonStep, CrankNicolsonStep) {
+        if let cached = cachedSteps, cached.dt == dt {
+            return (cached.radial, cached.axial)
+        }
+
+        let kineticScale = hBar * hBar / (2 * mass)
+        let m2 = Double(azimuthalNumber * azimuthalNumber)
+
+        // Radial: finite-volume fluxes through faces r_{i±½}; the axis face carries none
+        var radialWeights = [Double](repeating: 0, count: radialCount)
+        var radialDiagonal = [Double](repeating: 0, count: radialCount)
+        var radialOff = [Double](repeating: 0, count: max(radialCount - 1, 0))
+        for i in 0..<radialCount {
+            let r = radius(at: i)
+            let inner = Double(i) * dr
+            let outer = Double(i + 1) * dr
+            radialWeights[i] = r * dr
+            radialDiagonal[i] = kineticScale * ((inner + outer) / dr + m2 * dr / r)
+            if i < radialCount - 1 {
+                radialOff[i] = -kineticScale * outer / dr
+            }
+        }
+
+        // Axial: standard three-point Laplacian with unit weights
+        let dz = axialGrid.dx
+        let nz = axialGrid.count
+        let axialDiagonal = [Double](repeating: 2 * kineticScale / (dz * dz), count: nz)
+        let axialOff = [Double](repeating: -kineticScale / (dz * dz), count: max(nz - 1, 0))
+
+        let tau = dt / (2 * hBar)
+        let radial = CrankNicolsonStep(
+            weights: radialWeights, diagonal: radialDiagonal, offDiagonal: radialOff, tau: tau / 2)
+        let axial = CrankNicolsonStep(
+            weights: [Double](repeating: 1, count: nz), diagonal: axialDiagonal,
+            offDiagonal: axialOff, tau: tau)
+
+        cachedSteps = (dt, radial, axial)
+        return (radial, axial)
+    }
+}
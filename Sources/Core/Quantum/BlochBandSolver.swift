@@ -0,0 +1,320 @@
+import Accelerate
+import Foundation
+
+/// Band-structure solver for a 1D periodic potential, batched over k-points.
+///
+/// On a cell of M samples the discrete Hamiltonian gives the recurrence
+/// ψ_{j+1} = (2 + (V_j − E)/c) ψ_j − ψ_{j−1}, c = ħ²/2m dx², whose product over one cell is
+/// the monodromy matrix M(E). Bloch's theorem makes E an eigenvalue at wave number k exactly
+/// when its discriminant D(E) = Tr M(E) equals 2cos(ka). D is independent of k and monotone
+/// across each band, so one band's E_n(k) for every k is a batch of scalar root searches that
+/// share everything except the right-hand side:
+/// - the Dirichlet eigenvalues (one per gap, by Sturm bisection) bracket every band;
+/// - the band edges (D = ±2) and a table of D across each band are computed once and give
+///   each k-point a tight starting bracket;
+/// - the remaining bisection evaluates D for a block of k-points at once, with the k index
+///   innermost so the M-step transfer product vectorizes across k.
+final class BlochBandSolver {
+    /// Bands E_n(k) over a set of wave numbers
+    struct BandStructure {
+        let waveNumbers: [Double]
+        /// energies[n][i] = E_n(waveNumbers[i]) in Joules
+        let energies: [[Double]]
+        /// Energy range covered by each band
+        let bandEdges: [(bottom: Double, top: Double)]
+    }
+
+    /// Potential over one unit cell, sampled at x_j = j·a/M
+    let cellPotential: [Double]
+    /// Lattice constant a in meters
+    let latticeConstant: Double
+    let mass: Double
+
+    /// k-points handled together by one worker
+    var blockSize = 256
+
+    private let hBar = QuantumMath.reducedPlanckConstant
+    // Hopping energy c = ħ²/2m dx²
+    private let coupling: Double
+    // Samples of D(E) across each band used to seed per-k brackets
+    private let tableSize = 64
+
+    /// Samples per cell
+    var cellCount: Int {
+        return cellPotential.count
+    }
+
+    /// Grid spacing a/M
+    var dx: Double {
+        return latticeConstant / Double(cellCount)
+    }
+
+    init(cellPotential: [Double], latticeConstant: Double, mass: Double) {
+        precondition(cellPotential.count >= 2, "A unit cell needs at least two samples")
+        self.cellPotential = cellPotential
+        self.latticeConstant = latticeConstant
+        self.mass = mass
+
+        let dx = latticeConstant / Double(cellPotential.count)
+        self.coupling = hBar * hBar / (2 * mass * dx * dx)
+    }
+
+    // MARK: - Bands
+
+    /// Solve the lowest `bandCount` bands over `kPointCount` wave numbers spanning the first
+    /// Brillouin zone [−π/a, π/a]
+    func solve(bandCount: Int, kPointCount: Int) -> BandStructure {
+        let zoneEdge = Double.pi / latticeConstant
+        let step = 2 * zoneEdge / Double(max(kPointCount - 1, 1))
+        return solve(bandCount: bandCount, waveNumbers: (0..<kPointCount).map { -zoneEdge + Double($0) * step })
+    }
+
+    /// Solve the lowest `bandCount` bands at the given wave numbers
+    func solve(bandCount: Int, waveNumbers: [Double]) -> BandStructure {
+        let bands = min(bandCount, cellCount)
+        let edges = bandEdges(count: bands)
+        let targets = waveNumbers.map { 2 * cos($0 * latticeConstant) }
+
+        var energies = [[Double]](repeating: [], count: bands)
+        for n in 0..<bands {
+            energies[n] = solveBand(n, edges: edges[n], targets: targets)
+        }
+
+        return BandStructure(waveNumbers: waveNumbers, energies: energies, bandEdges: edges)
+    }
+
+    /// Bloch state ψ_{n,k} on one cell (normalized over the cell) for an energy from `solve`
+    func blochState(energy: Double, waveNumber: Double) -> ComplexArray {
+        let m = cellCount
+        let monodromy = transferProduct(energy: energy)
+        let lambda = Complex.fromPolar(r: 1, theta: waveNumber * latticeConstant)
+
+        // Eigenvector of M with eigenvalue e^{ika}, from whichever row is better conditioned
+        var current: Complex
+        var previous: Complex
+        if abs(monodromy.q) > abs(monodromy.r) {
+            current = Complex(real: monodromy.q, imaginary: 0)
+            previous = lambda - Complex(real: monodromy.p, imaginary: 0)
+        } else {
+            current = lambda - Complex(real: monodromy.s, imaginary: 0)
+            previous = Complex(real: monodromy.r, imaginary: 0)
+        }
+
+        var state = ComplexArray(count: m)
+        for j in 0..<m {
+            state[j] = current
+            let t = 2 + (cellPotential[j] - energy) / coupling
+            let next = t * current - previous
+            previous = current
+            current = next
+        }
+
+        state.normalize(dx: dx)
+        return state
+    }
+
+    /// Discriminant D(E) = Tr M(E)
+    func discriminant(at energy: Double) -> Double {
+        let monodromy = transferProduct(energy: energy)
+        return monodromy.p + monodromy.s
+    }
+
+    // MARK: - Band Edges
+
+    /// Bottom and top of the lowest `count` bands
+    func bandEdges(count: Int) -> [(bottom: Double, top: Double)] {
+        let lowest = cellPotential.min()!
+        let highest = cellPotential.max()! + 4 * coupling
+        let margin = 1e-9 * (highest - lowest)
+
+        // Gap brackets μ_0 < μ_1 < … with μ_n between bands n − 1 and n
+        var brackets = [lowest - margin]
+        brackets += dirichletEigenvalues(count: min(count, cellCount - 1))
+        if brackets.count <= count {
+            brackets.append(highest + margin)
+        }
+
+        return (0..<count).map { n in
+            // D runs from 2s to −2s across band n, s = (−1)ⁿ
+            let sign = n % 2 == 0 ? 1.0 : -1.0
+            let bottom = findRoot(in: brackets[n]...brackets[n + 1]) { sign * (self.discriminant(at: $0) - 2 * sign) }
+            let top = findRoot(in: bottom...brackets[n + 1]) { sign * (self.discriminant(at: $0) + 2 * sign) }
+            return (bottom, top)
+        }
+    }
+
+    // MARK: - Private Methods
+
+    /// E_n(k) for every target 2cos(ka), batched over blocks of k-points
+    private func solveBand(_ n: Int, edges: (bottom: Double, top: Double), targets: [Double]) -> [Double] {
+        let sign = n % 2 == 0 ? 1.0 : -1.0
+        let width = edges.top - edges.bottom
+        guard width > 0 else { return [Double](repeating: edges.bottom, count: targets.count) }
+
+        // Shared table of s·D(E) across the band (decreasing from 2 to −2)
+        let tableEnergies = (0...tableSize).map { edges.bottom + width * Double($0) / Double(tableSize) }
+        var tableValues = [Double](repeating: 0, count: tableEnergies.count)
+        var tableRows = [Double](repeating: 0, count: 4 * tableEnergies.count)
+        tableEnergies.withUnsafeBufferPointer { e in
+            tableValues.withUnsafeMutableBufferPointer { d in
+                tableRows.withUnsafeMutableBufferPointer { rows in
+                    discriminants(
+                        e.baseAddress!, into: d.baseAddress!, lanes: tableEnergies.count, rows: rows.baseAddress!)
+                }
+            }
+        }
+        tableValues = tableValues.map { sign * $0 }
+
+        // Bisection depth needed to shrink one table interval to rounding level
+        let tolerance = 4 * Double.ulpOfOne * max(abs(edges.bottom), abs(edges.top), coupling)
+        let iterations = max(0, Int(log2(width / Double(tableSize) / tolerance).rounded(.up)))
+
+        var energies = [Double](repeating: 0, count: targets.count)
+        let blocks = (targets.count + blockSize - 1) / blockSize
+
+        energies.withUnsafeMutableBufferPointer { output in
+            WorkerPool.shared.concurrentPerform(iterations: blocks) { block in
+                let start = block * blockSize
+                let lanes = min(blockSize, targets.count - start)
+
+                var low = [Double](repeating: 0, count: lanes)
+                var high = [Double](repeating: 0, count: lanes)
+                var target = [Double](repeating: 0, count: lanes)
+                var middle = [Double](repeating: 0, count: lanes)
+                var value = [Double](repeating: 0, count: lanes)
+                var rows = [Double](repeating: 0, count: 4 * lanes)
+
+                // Seed brackets from the shared table
+                for lane in 0..<lanes {
+                    target[lane] = sign * targets[start + lane]
+                    var lower = 0
+                    var upper = tableSize
+                    while upper - lower > 1 {
+                        let mid = (lower + upper) / 2
+                        if tableValues[mid] > target[lane] { lower = mid } else { upper = mid }
+                    }
+                    low[lane] = tableEnergies[lower]
+                    high[lane] = tableEnergies[upper]
+                }
+
+                // Lock-step bisection: every lane evaluates D at its own midpoint
+                for _ in 0..<iterations {
+                    for lane in 0..<lanes {
+                        middle[lane] = 0.5 * (low[lane] + high[lane])
+                    }
+                    middle.withUnsafeBufferPointer { e in
+                        value.withUnsafeMutableBufferPointer { d in
+                            rows.withUnsafeMutableBufferPointer { m in
+                                discriminants(e.baseAddress!, into: d.baseAddress!, lanes: lanes, rows: m.baseAddress!)
+                            }
+                        }
+                    }
+                    for lane in 0..<lanes {
+                        if sign * value[lane] > target[lane] {
+                            low[lane] = middle[lane]
+                        } else {
+                            high[lane] = middle[lane]
+                        }
+                    }
+                }
+
+                for lane in 0..<lanes {
+                    output[start + lane] = 0.5 * (low[lane] + high[lane])
+                }
+            }
+        }
+
+        return energies
+    }
+
+    /// D(E) for a batch of energies, with the energy index innermost.
+    /// `rows` is caller-owned scratch for 4·lanes values, so repeated calls do not allocate.
+    private func discriminants(
+        _ energies: UnsafePointer<Double>, into result: UnsafeMutablePointer<Double>, lanes: Int,
+        rows: UnsafeMutablePointer<Double>
+    ) {
+        // Rows (p, q) and (r, s) of the running product, one entry per lane
+        let p = rows
+        let q = p + lanes
+        let r = q + lanes
+        let s = r + lanes
+        for lane in 0..<lanes {
+            p[lane] = 1
+            q[lane] = 0
+            r[lane] = 0
+            s[lane] = 1
+        }
+
+        let inverseCoupling = 1 / coupling
+        for v in cellPotential {
+            // T·M with T = [[t, −1], [1, 0]]
+            for lane in 0..<lanes {
+                let t = 2 + (v - energies[lane]) * inverseCoupling
+                let newP = t * p[lane] - r[lane]
+                let newQ = t * q[lane] - s[lane]
+                r[lane] = p[lane]
+                s[lane] = q[lane]
+                p[lane] = newP
+                q[lane] = newQ
+            }
+        }
+
+        vDSP_vaddD(p, 1, s, 1, result, 1, vDSP_Length(lanes))
+    }
+
+    /// Monodromy matrix [[p, q], [r, s]] mapping (ψ₀, ψ₋₁) to (ψ_M, ψ_{M−1})
+    private func transferProduct(energy: Double) -> (p: Double, q: Double, r: Double, s: Double) {
+        var p = 1.0
+        var q = 0.0
+        var r = 0.0
+        var s = 1.0
+        for v in cellPotential {
+            let t = 2 + (v - energy) / coupling
+            (p, q, r, s) = (t * p - r, t * q - s, p, q)
+        }
+        return (p, q, r, s)
+    }
+
+    /// Eigenvalues of the open chain on sites 0…M−2 (ψ₋₁ = ψ_{M−1} = 0), lowest first.
+    /// These are the zeros of the monodromy entry r(E) (ψ₋₁ = 0 gives ψ_{M−1} = r ψ₀), one in each
+    /// spectral gap.
+    private func dirichletEigenvalues(count: Int) -> [Double] {
+        let lowest = cellPotential.min()!
+        let highest = cellPotential.max()! + 4 * coupling
+        let sites = cellCount - 1
+
+        // Sturm count: eigenvalues below E from the signs of the LDLᵀ pivots
+        func eigenvaluesBelow(_ energy: Double) -> Int {
+            var negatives = 0
+            var pivot = 1.0
+            for j in 0..<sites {
+                let diagonal = 2 * coupling + cellPotential[j] - energy
+                pivot = j == 0 ? diagonal : diagonal - coupling * coupling / pivot
+                if pivot == 0 { pivot = -Double.ulpOfOne * coupling }
+                if pivot < 0 { negatives += 1 }
+            }
+            return negatives
+        }
+
+        return (0..<count).map { index in
+            var low = lowest
+            var high = highest
+            for _ in 0..<100 where high - low > 2 * Double.ulpOfOne * max(abs(low), abs(high)) {
+                let middle = 0.5 * (low + high)
+                if eigenvaluesBelow(middle) > index { high = middle } else { low = middle }
+            }
+            return 0.5 * (low + high)
+        }
+    }
+
+    /// Bisection for the sign change of a function that is positive at the lower end
+    private func findRoot(in range: ClosedRange<Double>, _ function: (Double) -> Double) -> Double {
+        var low = range.lowerBound
+        var high = range.upperBound
+        for _ in 0..<200 where high - low > 2 * Double.ulpOfOne * max(abs(low), abs(high)) {
+            let middle = 0.5 * (low + high)
+            if function(middle) > 0 { low = middle } else { high = middle }
+        }
+        return 0.5 * (low + high)
+    }
+}
@@ -0,0 +1,87 @@
+import Foundation
+
+/// Vector instruction sets of the host, read once at startup, for kernels that pick their SIMD
+/// width at run time.
+///
+/// Detection uses the `hw.optional.*` sysctls (the kernel's cpuid/hwcap summary). Tests and
+/// benchmarks can force a narrower level with `override` or the `QWF_VECTOR_LEVEL` environment
+/// variable (`scalar`, `neon`, `avx2`, `avx512`), so each kernel variant runs on any machine.
+/// Accelerate routines pick their own code paths and are not affected.
+struct CPUFeatures: Equatable {
+    enum VectorLevel: Int, Comparable, CaseIterable {
+        case scalar
+        case neon
+        case avx2
+        case avx512
+
+        /// Doubles per native vector register
+        var doubleLanes: Int {
+            switch self {
+            case .scalar: return 1
+            case .neon: return 2
+            case .avx2: return 4
+            case .avx512: return 8
+            }
+        }
+
+        var name: String {
+            switch self {
+            case .scalar: return "scalar"
+            case .neon: return "neon"
+            case .avx2: return "avx2"
+            case .avx512: return "avx512"
+            }
+        }
+
+        static func < (lhs: VectorLevel, rhs: VectorLevel) -> Bool {
+            return lhs.rawValue < rhs.rawValue
+        }
+    }
+
+    let vectorLevel: VectorLevel
+
+    /// What the host supports
+    static let detected = CPUFeatures(vectorLevel: detectVectorLevel())
+
+    /// Forces the features used for dispatch; nil uses the environment override or detection
+    static var override: CPUFeatures?
+
+    /// Features kernels dispatch on
+    static var current: CPUFeatures {
+        if let forced = override {
+            return forced
+        }
+        return environmentOverride ?? detected
+    }
+
+    private static let environmentOverride: CPUFeatures? = {
+        guard let value = ProcessInfo.processInfo.environment["QWF_VECTOR_LEVEL"]?.lowercased(),
+            let level = VectorLevel.allCases.first(where: { $0.name == value })
+        else {
+            return nil
+        }
+        return CPUFeatures(vectorLevel: level)
+    }()
+
+    // MARK: - Private Methods
+
+    private static func detectVectorLevel() -> VectorLevel {
+        #if arch(x86_64)
+            if sysctlFlag("hw.optional.avx512f") {
+                return .avx512
+            }
+            return sysctlFlag("hw.optional.avx2_0") ? .avx2 : .scalar
+        #elseif arch(arm64)
+            // Advanced SIMD is part of the arm64 base architecture
+            return .neon
+        #else
+            return .scalar
+        #endif
+    }
+
+    private static func sysctlFlag(_ name: String) -> Bool {
+        var value: Int32 = 0
+        var size = MemoryLayout<Int32>.size
+        return sysctlbyname(name, &value, &size, nil, 0) == 0 && value != 0
+    }
+}
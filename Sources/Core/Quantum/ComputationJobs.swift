@@ -0,0 +1,100 @@
+import Foundation
+
+/// Cooperative cancellation flag shared between a job and the kernels it runs.
+///
+/// Kernels that accept a token check it once per outer iteration (a time step, an optimizer
+/// iteration, a group of map lanes) and return early with whatever partial result they have.
+/// A cancelled job's result is never delivered, so the partial value is only a way out.
+final class CancellationToken {
+    private let lock = NSLock()
+    private var cancelled = false
+
+    var isCancelled: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return cancelled
+    }
+
+    func cancel() {
+        lock.lock()
+        cancelled = true
+        lock.unlock()
+    }
+}
+
+/// Runs computations keyed by target so that only the latest request for a target does work.
+///
+/// Submitting a job for a target cancels the one already queued or running for it. A job that
+/// has not started yet is skipped entirely, one that is running stops at its next token check,
+/// and only the newest job's result reaches its completion handler, which runs on the main queue.
+final class SupersedingJobQueue {
+    private let queue: DispatchQueue?
+    private let lock = NSLock()
+    private var tokens: [String: CancellationToken] = [:]
+
+    /// - Parameter queue: Queue the work runs on when a submission does not name one; by default
+    ///   it runs on the simulation workers of `WorkerPool.shared`, below the audio render thread
+    init(queue: DispatchQueue? = nil) {
+        self.queue = queue
+    }
+
+    /// Run `work` for `target`, superseding any earlier job for the same target
+    /// - Parameters:
+    ///   - target: What the job computes; a newer job with the same target replaces this one
+    ///   - queue: Queue to run `work` on (e.g. `.main` for state that is only touched there)
+    ///   - work: The computation; pass the token on to the kernels it calls
+    ///   - completion: Receives the result on the main queue, unless the job was superseded
+    /// - Returns: The job's token, for cancelling it explicitly
+    @discardableResult
+    func submit<Result>(
+        target: String, on queue: DispatchQueue? = nil, work: @escaping (CancellationToken) -> Result,
+        completion: ((Result) -> Void)? = nil
+    ) -> CancellationToken {
+        let token = CancellationToken()
+        lock.lock()
+        tokens[target]?.cancel()
+        tokens[target] = token
+        lock.unlock()
+
+        let job = {
+            guard !token.isCancelled else { return }
+            let result = work(token)
+
+            DispatchQueue.main.async {
+                guard self.finish(target, token) else { return }
+                completion?(result)
+            }
+        }
+        if let queue = queue ?? self.queue {
+            queue.async(execute: job)
+        } else {
+            WorkerPool.shared.async(job)
+        }
+        return token
+    }
+
+    /// Cancel the pending or running job for `target`
+    func cancel(target: String) {
+        lock.lock()
+        tokens.removeValue(forKey: target)?.cancel()
+        lock.unlock()
+    }
+
+    /// Cancel every pending or running job
+    func cancelAll() {
+        lock.lock()
+        tokens.values.forEach { $0.cancel() }
+        tokens.removeAll()
+        lock.unlock()
+    }
+
+    /// Retire `token` if it is still the newest for `target` and was not cancelled
+    private func finish(_ target: String, _ token: CancellationToken) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard tokens[target] === token, !token.isCancelled else { return false }
+        tokens.removeValue(forKey: target)
+        return true
+    }
+}
@@ -0,0 +1,131 @@
+import Accelerate
+import Foundation
+import simd
+
+/// Split-step propagator for the 1D Dirac equation iħ∂ψ/∂t = (cσ_x p + σ_z mc² + V)ψ.
+///
+/// The free Dirac Hamiltonian is diagonal in k, where it is the 2×2 spin field
+/// (cħk, 0, mc²)·σ, so its exact propagator is one SU(2) rotation per wave number. The
+/// potential is a scalar phase in position space. Both stages reuse the interleaved spinor
+/// storage and the fused 2×2 kernels of `SpinorPropagator`, so a step costs one FFT pair per
+/// component plus two SIMD2 passes, the same per point as the scalar split-operator step.
+///
+/// Relativistic length scales (the reduced Compton wavelength ħ/mc ≈ 0.4 pm for an electron)
+/// are far below the nanometer grids used elsewhere, so `speedOfLight` can be lowered to bring
+/// Zitterbewegung and Klein tunneling onto the same scale as the non-relativistic views.
+final class DiracPropagator {
+    let grid: QuantumGrid
+    let mass: Double
+    /// Effective speed of light in m/s
+    let speedOfLight: Double
+    /// Potential energy in Joules
+    let potential: [Double]
+
+    private let hBar = QuantumMath.reducedPlanckConstant
+    private let fft: FFTPlan
+
+    /// Rest energy mc² in Joules
+    var restEnergy: Double {
+        return mass * speedOfLight * speedOfLight
+    }
+
+    /// Reduced Compton wavelength ħ/mc, the Zitterbewegung amplitude scale
+    var comptonWavelength: Double {
+        return hBar / (mass * speedOfLight)
+    }
+
+    /// - Parameters:
+    ///   - grid: Periodic grid (power-of-two size)
+    ///   - mass: Particle mass in kg
+    ///   - potential: Potential energy in Joules at every grid point
+    ///   - speedOfLight: Effective speed of light (defaults to c)
+    init(grid: QuantumGrid, mass: Double, potential: [Double], speedOfLight: Double = QuantumMath.speedOfLight) {
+        precondition(potential.count == grid.count, "Potential must match grid size")
+        self.grid = grid
+        self.mass = mass
+        self.potential = potential
+        self.speedOfLight = speedOfLight
+        self.fft = FFTPlan(count: grid.count)
+    }
+
+    // MARK: - States
+
+    /// Gaussian packet built only from positive-energy plane waves: each k component carries the
+    /// upper eigenvector (cos θ/2, sin θ/2) of the free Hamiltonian, tan θ = ħk/mc.
+    /// A packet with both energy signs (e.g. all weight in the upper component) shows Zitterbewegung.
+    func makePositiveEnergyPacket(center: Double, width: Double, waveNumber: Double) -> SpinorArray {
+        var envelope = ComplexArray(count: grid.count)
+        for j in 0..<grid.count {
+            let offset = grid.position(at: j) - center
+            let amplitude = exp(-offset * offset / (2 * width * width))
+            envelope[j] = amplitude * Complex.fromPolar(r: 1, theta: waveNumber * grid.position(at: j))
+        }
+
+        envelope.withSplitComplex { fft.forward($0) }
+
+        var spectrum = SpinorArray(count: grid.count)
+        let waveNumbers = grid.waveNumbers
+        let scale = 1.0 / Double(grid.count)
+        for j in 0..<grid.count {
+            let theta = atan2(hBar * waveNumbers[j], mass * speedOfLight)
+            let value = scale * envelope[j]
+            spectrum.real[2 * j] = cos(theta / 2) * value.real
+            spectrum.imaginary[2 * j] = cos(theta / 2) * value.imaginary
+            spectrum.real[2 * j + 1] = sin(theta / 2) * value.real
+            spectrum.imaginary[2 * j + 1] = sin(theta / 2) * value.imaginary
+        }
+
+        spectrum.fourierTransform(using: fft, inverse: true)
+        spectrum.normalize(cellVolume: grid.dx)
+        return spectrum
+    }
+
+    // MARK: - Observables
+
+    /// Probability density ψ†ψ for rendering
+    func probabilityDensity(_ psi: SpinorArray) -> [Double] {
+        return psi.probabilityDensity
+    }
+
+    /// Probability current j = c ψ†σ_xψ = 2c Re(ψ₁*ψ₂)
+    func probabilityCurrent(_ psi: SpinorArray) -> [Double] {
+        return (0..<psi.count).map { j in
+            2 * speedOfLight
+                * (psi.real[2 * j] * psi.real[2 * j + 1] + psi.imaginary[2 * j] * psi.imaginary[2 * j + 1])
+        }
+    }
+
+    /// Expectation value ⟨x⟩ (tracks Zitterbewegung)
+    func expectationPosition(_ psi: SpinorArray) -> Double {
+        var result = 0.0
+        vDSP_dotprD(psi.probabilityDensity, 1, grid.positions, 1, &result, vDSP_Length(grid.count))
+        return result * grid.dx
+    }
+
+    // MARK: - Propagation
+
+    /// Advance ψ by `steps` Strang steps of size `dt`
+    func propagate(_ psi: inout SpinorArray, timeStep dt: Double, steps: Int) {
+        guard steps > 0 else { return }
+        precondition(psi.count == grid.count, "Spinor does not match propagator grid")
+
+        let noSpinField = [SIMD3<Double>](repeating: .zero, count: grid.count)
+        let potentialHalf = SpinMatrixTable(scalar: potential, field: noSpinField, duration: dt / 2)
+        let potentialFull = SpinMatrixTable(scalar: potential, field: noSpinField, duration: dt)
+
+        // Free Dirac propagator in k space: rotation about (cħk, 0, mc²)
+        let freeField = grid.waveNumbers.map { SIMD3(speedOfLight * hBar * $0, 0, restEnergy) }
+        let free = SpinMatrixTable(
+            scalar: [Double](repeating: 0, count: grid.count), field: freeField, duration: dt,
+            scale: 1.0 / Double(grid.count))
+
+        potentialHalf.apply(to: &psi)
+        for step in 0..<steps {
+            psi.fourierTransform(using: fft, inverse: false)
+            free.apply(to: &psi)
+            psi.fourierTransform(using: fft, inverse: true)
+
+            (step == steps - 1 ? potentialHalf : potentialFull).apply(to: &psi)
+        }
+    }
+}
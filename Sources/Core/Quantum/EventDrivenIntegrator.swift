@@ -0,0 +1,284 @@
+import Accelerate
+import Foundation
+
+/// Scalar observables of one state, evaluated together after every step
+struct StepObservables {
+    /// Simulation time in seconds since the start of the run
+    let time: Double
+    /// ∫|ψ|² dx
+    let norm: Double
+    /// ⟨x⟩ in meters
+    let meanPosition: Double
+    /// ∫|ψ|² dx over each configured region
+    let regionProbabilities: [Double]
+    /// ∫ j dt at each configured detector since the start of the run
+    let integratedFlux: [Double]
+}
+
+/// A condition watched during a run. It occurs where `function` changes sign in `direction`.
+struct ObservableEvent {
+    enum Direction {
+        case rising
+        case falling
+        case either
+    }
+
+    enum Action {
+        /// End the run with the state at the event
+        case stop
+        /// Keep a copy of the state at the event and continue
+        case checkpoint
+        /// Report the event and continue
+        case emit
+    }
+
+    let name: String
+    let direction: Direction
+    let action: Action
+    let function: (StepObservables) -> Double
+
+    init(
+        name: String, direction: Direction = .either, action: Action = .emit,
+        function: @escaping (StepObservables) -> Double
+    ) {
+        self.name = name
+        self.direction = direction
+        self.action = action
+        self.function = function
+    }
+
+    /// Probability inside region `region` falls below `threshold`
+    static func regionDepleted(region: Int, below threshold: Double, action: Action = .stop) -> ObservableEvent {
+        return ObservableEvent(name: "region \(region) depleted", direction: .falling, action: action) {
+            $0.regionProbabilities[region] - threshold
+        }
+    }
+
+    /// Integrated flux through detector `detector` rises through `level`
+    static func fluxReached(detector: Int, level: Double, action: Action = .stop) -> ObservableEvent {
+        return ObservableEvent(name: "detector \(detector) reached \(level)", direction: .rising, action: action) {
+            $0.integratedFlux[detector] - level
+        }
+    }
+
+    /// Total norm falls below `threshold` (absorbing or dissipative runs)
+    static func normBelow(_ threshold: Double, action: Action = .stop) -> ObservableEvent {
+        return ObservableEvent(name: "norm below \(threshold)", direction: .falling, action: action) {
+            $0.norm - threshold
+        }
+    }
+
+    func occurs(from previous: Double, to current: Double) -> Bool {
+        let rising = previous < 0 && current >= 0
+        let falling = previous > 0 && current <= 0
+        switch direction {
+        case .rising: return rising
+        case .falling: return falling
+        case .either: return rising || falling
+        }
+    }
+}
+
+/// Step-by-step driver that watches observables and acts on events.
+///
+/// After every step the norm, mean position and region probabilities are evaluated from one
+/// density pass, the detector currents from the spectral sums of `FluxDetectors`, and all of
+/// them are handed to each event function. When one changes sign,
+/// the event time inside the step is refined by Illinois regula falsi, re-propagating from
+/// the start of the step by the trial offset, so events are located to a small fraction of a
+/// step without shrinking the step everywhere. A `.stop` event ends the run at the refined
+/// time, which lets sweeps skip the steps after the answer is known.
+final class EventDrivenIntegrator {
+    struct Configuration {
+        /// Refinement stops once the bracket is shorter than this fraction of a step
+        var timeTolerance = 1e-6
+        /// Maximum root-finding iterations per event
+        var maxRefinements = 40
+    }
+
+    /// One event as it happened
+    struct Occurrence {
+        let name: String
+        let action: ObservableEvent.Action
+        let observables: StepObservables
+        /// State at the event for `.checkpoint` and `.stop`
+        let state: ComplexArray?
+    }
+
+    struct Result {
+        let finalState: ComplexArray
+        let finalObservables: StepObservables
+        let stepsTaken: Int
+        let occurrences: [Occurrence]
+        /// Whether a `.stop` event ended the run early
+        let stopped: Bool
+    }
+
+    let propagator: QuantumPropagator
+    /// Regions in meters whose probabilities are observed
+    let regions: [ClosedRange<Double>]
+    var configuration: Configuration
+
+    private let detectors: FluxDetectors
+    private let positions: [Double]
+    private let regionIndices: [Range<Int>]
+
+    var grid: QuantumGrid {
+        return propagator.grid
+    }
+
+    init(
+        propagator: QuantumPropagator, mass: Double, regions: [ClosedRange<Double>] = [],
+        detectorPositions: [Double] = [], configuration: Configuration = Configuration()
+    ) {
+        let grid = propagator.grid
+        self.propagator = propagator
+        self.regions = regions
+        self.configuration = configuration
+        self.detectors = FluxDetectors(positions: detectorPositions, grid: grid, mass: mass)
+        self.positions = grid.positions
+        self.regionIndices = regions.map { region in
+            let lower = Int(((region.lowerBound - grid.xMin) / grid.dx).rounded(.up))
+            let upper = Int(((region.upperBound - grid.xMin) / grid.dx).rounded(.down)) + 1
+            let clampedLower = min(max(lower, 0), grid.count)
+            return clampedLower..<min(max(upper, clampedLower), grid.count)
+        }
+    }
+
+    /// Observables of `psi` at `time` with the given detector fluxes
+    func observe(_ psi: ComplexArray, time: Double, integratedFlux: [Double]) -> StepObservables {
+        let dx = grid.dx
+        let density = psi.probabilityDensity
+        let length = vDSP_Length(density.count)
+
+        var total = 0.0
+        var moment = 0.0
+        vDSP_sveD(density, 1, &total, length)
+        vDSP_dotprD(positions, 1, density, 1, &moment, length)
+
+        let regionProbabilities = density.withUnsafeBufferPointer { buffer in
+            regionIndices.map { range -> Double in
+                var sum = 0.0
+                if !range.isEmpty {
+                    vDSP_sveD(buffer.baseAddress! + range.lowerBound, 1, &sum, vDSP_Length(range.count))
+                }
+                return sum * dx
+            }
+        }
+
+        return StepObservables(
+            time: time, norm: total * dx, meanPosition: total > 0 ? moment / total : 0,
+            regionProbabilities: regionProbabilities, integratedFlux: integratedFlux)
+    }
+
+    /// Advance `initialState` by up to `maxSteps` steps, acting on `events` as they occur
+    /// - Parameters:
+    ///   - onEvent: Called for every occurrence, in time order
+    ///   - cancellation: Checked before each step; the run ends as if it had reached `maxSteps`
+    func run(
+        _ initialState: ComplexArray, timeStep dt: Double, maxSteps: Int, events: [ObservableEvent],
+        onEvent: ((Occurrence) -> Void)? = nil, cancellation: CancellationToken? = nil
+    ) -> Result {
+        precondition(initialState.count == grid.count, "State does not match propagator grid")
+
+        var psi = initialState
+        var flux = detectors
+        var observables = observe(psi, time: 0, integratedFlux: flux.integratedFlux)
+        var values = events.map { $0.function(observables) }
+        var occurrences = [Occurrence]()
+        var stepsTaken = 0
+
+        for step in 0..<max(0, maxSteps) {
+            if cancellation?.isCancelled == true {
+                break
+            }
+            stepsTaken = step + 1
+            let start = psi
+            let startObservables = observables
+
+            propagator.propagate(&psi, timeStep: dt, steps: 1)
+            flux.accumulate(psi, timeStep: dt)
+            observables = observe(psi, time: Double(step + 1) * dt, integratedFlux: flux.integratedFlux)
+            let next = events.map { $0.function(observables) }
+
+            // Refine every event in this step, then act on them in time order
+            var hits = [(event: ObservableEvent, state: ComplexArray, observables: StepObservables)]()
+            for (index, event) in events.enumerated() where event.occurs(from: values[index], to: next[index]) {
+                let hit = refine(
+                    event, from: start, startObservables: startObservables, startValue: values[index],
+                    end: psi, endObservables: observables, endValue: next[index], timeStep: dt)
+                hits.append((event, hit.state, hit.observables))
+            }
+            hits.sort { $0.observables.time < $1.observables.time }
+
+            for hit in hits {
+                let occurrence = Occurrence(
+                    name: hit.event.name, action: hit.event.action, observables: hit.observables,
+                    state: hit.event.action == .emit ? nil : hit.state)
+                occurrences.append(occurrence)
+                onEvent?(occurrence)
+
+                if hit.event.action == .stop {
+                    return Result(
+                        finalState: hit.state, finalObservables: hit.observables, stepsTaken: step + 1,
+                        occurrences: occurrences, stopped: true)
+                }
+            }
+            values = next
+        }
+
+        return Result(
+            finalState: psi, finalObservables: observables, stepsTaken: stepsTaken, occurrences: occurrences,
+            stopped: false)
+    }
+
+    // MARK: - Private Methods
+
+    /// Illinois regula falsi on the event function over the step, re-propagating from its start
+    private func refine(
+        _ event: ObservableEvent, from start: ComplexArray, startObservables: StepObservables, startValue: Double,
+        end: ComplexArray, endObservables: StepObservables, endValue: Double, timeStep dt: Double
+    ) -> (state: ComplexArray, observables: StepObservables) {
+        var lower = (offset: 0.0, value: startValue)
+        var upper = (offset: dt, value: endValue, state: end, observables: endObservables)
+        var retained = 0
+        var iterations = 0
+
+        while iterations < configuration.maxRefinements
+            && upper.offset - lower.offset > configuration.timeTolerance * dt
+        {
+            iterations += 1
+            let denominator = upper.value - lower.value
+            var offset = denominator != 0
+                ? (lower.offset * upper.value - upper.offset * lower.value) / denominator
+                : 0.5 * (lower.offset + upper.offset)
+            if !(offset > lower.offset && offset < upper.offset) {
+                offset = 0.5 * (lower.offset + upper.offset)
+            }
+
+            var state = start
+            propagator.propagate(&state, timeStep: offset, steps: 1)
+            let fluxes = zip(startObservables.integratedFlux, detectors.currents(state)).map { $0 + offset * $1 }
+            let observables = observe(state, time: startObservables.time + offset, integratedFlux: fluxes)
+            let value = event.function(observables)
+
+            // Keep the bracket around the sign change; halve the stale end's value when one
+            // end is retained twice in a row so the interpolation does not stall
+            if value == 0 || (value < 0) != (lower.value < 0) {
+                upper = (offset, value, state, observables)
+                if retained < 0 {
+                    lower.value /= 2
+                }
+                retained = -1
+            } else {
+                lower = (offset, value)
+                if retained > 0 {
+                    upper.value /= 2
+                }
+                retained = 1
+            }
+        }
+
+        return (upper.state, upper.observables)
+    }
+}
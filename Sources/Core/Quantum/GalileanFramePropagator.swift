@@ -0,0 +1,187 @@
+import Accelerate
+import Foundation
+
+/// Split-operator propagator for fast wave packets evolved in a co-moving (Galilean) frame.
+///
+/// A packet with central wave number k₀ is written as ψ(x, t) = φ(ξ, t) · e^{i(k₀x - ω₀t)}
+/// with ξ = x - x_f(t), x_f(t) = x_f(0) + v t, v = ħk₀/m and ω₀ = ħk₀²/2m. Substituting
+/// removes both the carrier and the advection term, leaving the smooth envelope φ to obey
+/// iħ∂φ/∂t = -ħ²/2m ∂²φ/∂ξ² + V(ξ + x_f(t)) φ.
+/// The envelope grid therefore only has to resolve the packet width, not the carrier
+/// wavelength, and only has to cover the packet rather than the whole lab domain.
+///
+/// A potential that reflects part of the packet breaks both assumptions: the reflected wave has
+/// k ≈ -k₀, so its envelope oscillates at -2k₀ and it moves away from the frame at twice the
+/// group velocity. `aliasesReflections` tells whether the envelope grid can represent it at all.
+/// Either way the window edges absorb whatever leaves the packet, and the absorbed norm is
+/// reported in `State.escapedNorm` rather than wrapped onto the other side of the window.
+final class GalileanFramePropagator {
+    /// Envelope plus the frame position and time it refers to
+    struct State {
+        /// Carrier-free envelope φ sampled on the co-moving grid
+        var envelope: ComplexArray
+        /// Simulation time in seconds
+        var time: Double
+        /// Lab-frame position of the co-moving grid origin at `time`
+        var frameOrigin: Double
+        /// Integrated norm absorbed at the window edges so far (mostly reflected density)
+        var escapedNorm: Double = 0
+
+        /// |ψ|² on the co-moving grid; the carrier has unit modulus so no reconstruction is needed
+        var probabilityDensity: [Double] {
+            return envelope.probabilityDensity
+        }
+    }
+
+    /// Co-moving grid; `grid.xMin…grid.xMax` are offsets relative to the frame origin
+    let grid: QuantumGrid
+    let mass: Double
+    /// Carrier wave number k₀ in m⁻¹
+    let carrierWaveNumber: Double
+    /// Lab-frame potential energy V(x) in Joules, or nil for a free packet
+    let potential: ((Double) -> Double)?
+    /// Absorbing layers at both ends of the window
+    let edges: AbsorbingEdges
+
+    private let hBar = QuantumMath.reducedPlanckConstant
+    private let fft: FFTPlan
+
+    /// Group velocity v = ħk₀/m of the co-moving frame
+    var frameVelocity: Double {
+        return hBar * carrierWaveNumber / mass
+    }
+
+    /// Carrier angular frequency ω₀ = ħk₀²/2m
+    var carrierFrequency: Double {
+        return hBar * carrierWaveNumber * carrierWaveNumber / (2 * mass)
+    }
+
+    /// Whether a reflected wave (envelope wave number ≈ -2k₀) lies beyond the envelope grid's
+    /// Nyquist limit and would fold back onto the forward-moving envelope. Always false without a
+    /// potential; π/Δξ > 2|k₀| is necessary, and the packet's spectral width needs some margin on top.
+    var aliasesReflections: Bool {
+        return potential != nil && Double.pi / grid.dx <= 2 * abs(carrierWaveNumber)
+    }
+
+    /// - Parameters:
+    ///   - grid: Co-moving grid of relative offsets; `grid.count` must be a power of two
+    ///   - mass: Particle mass in kg
+    ///   - carrierWaveNumber: Central wave number k₀ factored out of the envelope
+    ///   - potential: Lab-frame potential V(x) in Joules (nil for free propagation)
+    ///   - absorbingFraction: Fraction of the window at each end that absorbs outgoing density
+    init(
+        grid: QuantumGrid, mass: Double, carrierWaveNumber: Double, potential: ((Double) -> Double)? = nil,
+        absorbingFraction: Double = 0.125
+    ) {
+        self.grid = grid
+        self.mass = mass
+        self.carrierWaveNumber = carrierWaveNumber
+        self.potential = potential
+        self.edges = AbsorbingEdges(count: grid.count, layerCells: Int(absorbingFraction * Double(grid.count)))
+        self.fft = FFTPlan(count: grid.count)
+    }
+
+    // MARK: - Conversion
+
+    /// Remove the carrier from a lab-frame wave function and resample it onto the co-moving grid
+    /// - Parameters:
+    ///   - psi: Lab-frame wave function
+    ///   - labGrid: Grid `psi` is sampled on
+    ///   - frameOrigin: Lab position of the co-moving origin (usually the packet center)
+    ///   - time: Time the lab state refers to
+    func makeState(from psi: ComplexArray, on labGrid: QuantumGrid, frameOrigin: Double, time: Double = 0)
+        -> State
+    {
+        var envelope = ComplexArray(count: grid.count)
+        let carrierPhaseOffset = carrierFrequency * time
+
+        for i in 0..<grid.count {
+            let x = frameOrigin + grid.position(at: i)
+            let sample = psi.sample(at: x, on: labGrid)
+
+            // φ = ψ · e^{-i(k₀x - ω₀t)}
+            let carrier = Complex.fromPolar(r: 1, theta: -(carrierWaveNumber * x - carrierPhaseOffset))
+            envelope[i] = sample * carrier
+        }
+
+        return State(envelope: envelope, time: time, frameOrigin: frameOrigin)
+    }
+
+    /// Reconstruct the full lab-frame ψ on demand (for observables and rendering).
+    /// Points outside the co-moving window are zero.
+    func reconstructWaveFunction(_ state: State, on labGrid: QuantumGrid) -> ComplexArray {
+        var psi = ComplexArray(count: labGrid.count)
+        let carrierPhaseOffset = carrierFrequency * state.time
+        let windowStart = state.frameOrigin + grid.xMin
+        let windowEnd = state.frameOrigin + grid.xMax
+        let envelopeGrid = QuantumGrid(xMin: windowStart, xMax: windowEnd, count: grid.count)
+
+        for i in 0..<labGrid.count {
+            let x = labGrid.position(at: i)
+            guard x >= windowStart && x < windowEnd else { continue }
+
+            let sample = state.envelope.sample(at: x, on: envelopeGrid)
+            let carrier = Complex.fromPolar(r: 1, theta: carrierWaveNumber * x - carrierPhaseOffset)
+            psi[i] = sample * carrier
+        }
+
+        return psi
+    }
+
+    // MARK: - Propagation
+
+    /// Advance the envelope by `steps` Strang steps of size `dt` and move the frame with the packet.
+    /// Density absorbed at the window edges is added to `state.escapedNorm`.
+    func propagate(_ state: inout State, timeStep dt: Double, steps: Int) {
+        guard steps > 0 else { return }
+        precondition(state.envelope.count == grid.count, "State does not match propagator grid")
+
+        let length = vDSP_Length(grid.count)
+        let velocity = frameVelocity
+        let offsets = grid.positions
+
+        var kinetic = FFTPlan.phaseTable(
+            angles: grid.waveNumbers.map { -hBar * $0 * $0 * dt / (2 * mass) },
+            scale: 1.0 / Double(grid.count))
+
+        // The lab potential is sampled at the moving frame position, so its phase table
+        // changes every step; a free packet skips the potential stage entirely.
+        func potentialPhase(origin: Double) -> ComplexArray {
+            guard let potential = potential else { return ComplexArray(count: 0) }
+            return FFTPlan.phaseTable(angles: offsets.map { -potential(origin + $0) * dt / (2 * hBar) })
+        }
+
+        var origin = state.frameOrigin
+        // Phase table at the current frame position, shared by the trailing half-step
+        // of one step and the leading half-step of the next
+        var half = potentialPhase(origin: origin)
+        var escaped = 0.0
+
+        state.envelope.withSplitComplex { envelope in
+            kinetic.withSplitComplex { k in
+                for _ in 0..<steps {
+                    if potential != nil {
+                        half.withSplitComplex { vDSP_zvmulD(envelope, 1, $0, 1, envelope, 1, length, 1) }
+                    }
+
+                    fft.forward(envelope)
+                    vDSP_zvmulD(envelope, 1, k, 1, envelope, 1, length, 1)
+                    fft.inverse(envelope)
+
+                    origin += velocity * dt
+
+                    if potential != nil {
+                        half = potentialPhase(origin: origin)
+                        half.withSplitComplex { vDSP_zvmulD(envelope, 1, $0, 1, envelope, 1, length, 1) }
+                    }
+
+                    escaped += edges.apply(to: envelope, dx: grid.dx)
+                }
+            }
+        }
+
+        state.escapedNorm += escaped
+        state.frameOrigin = origin
+        state.time += dt * Double(steps)
+    }
+}
@@ -0,0 +1,152 @@
+import Foundation
+
+/// Memory for large simulation grids and engine scratch buffers.
+///
+/// Blocks are mapped with `mmap`, so they start on a page (and therefore a cache line).
+/// Blocks of 2 MB and up ask for 2 MB superpages where the kernel offers them (Intel Macs) and
+/// fall back to normal pages elsewhere. Large blocks are zeroed in tiles on `WorkerPool`, which
+/// spreads the page faults of a fresh mapping over the cores. Darwin has a single memory node
+/// and no NUMA binding, so which worker touches a page does not decide where it lives. Released
+/// blocks are pooled by size, so an engine that needs the same scratch every step faults its
+/// pages in only once.
+///
+/// Engines opt in buffer by buffer; today only the transpose scratch of `ADIPropagator` does.
+/// `ComplexArray`, `TwoParticleState` and the states and factors built from them stay on Swift
+/// arrays: their `[Double]` components are handed to vDSP directly and copied by value
+/// throughout the engines, so moving them here is a storage change of its own.
+final class GridAllocator {
+    static let shared = GridAllocator()
+
+    /// Bytes zeroed per parallel tile
+    var tileSize = 1 << 20
+    /// Most bytes kept in the pool for reuse
+    var poolLimit = 256 << 20
+
+    private let pageSize = Int(getpagesize())
+    private let superpageSize = 2 << 20
+    private let lock = NSLock()
+    private var pool: [Int: [UnsafeMutableRawPointer]] = [:]
+    private var pooledBytes = 0
+
+    private init() {}
+
+    /// Size actually mapped for a request: whole pages, or whole superpages from 2 MB up
+    func blockSize(for byteCount: Int) -> Int {
+        let unit = byteCount >= superpageSize ? superpageSize : pageSize
+        return (max(byteCount, 1) + unit - 1) / unit * unit
+    }
+
+    /// Page-aligned block of at least `byteCount` bytes
+    /// - Parameter zeroed: Zero the block in parallel tiles; fresh blocks are always zero
+    func allocate(byteCount: Int, zeroed: Bool = true) -> UnsafeMutableRawPointer {
+        let size = blockSize(for: byteCount)
+
+        lock.lock()
+        let reused = pool[size]?.popLast()
+        if reused != nil {
+            pooledBytes -= size
+        }
+        lock.unlock()
+
+        if let block = reused {
+            if zeroed {
+                zero(block, byteCount: size)
+            }
+            return block
+        }
+
+        let block = map(size)
+        zero(block, byteCount: size)
+        return block
+    }
+
+    /// Return a block from `allocate(byteCount:)` with the same `byteCount`
+    func deallocate(_ block: UnsafeMutableRawPointer, byteCount: Int) {
+        let size = blockSize(for: byteCount)
+
+        lock.lock()
+        if pooledBytes + size <= poolLimit {
+            pool[size, default: []].append(block)
+            pooledBytes += size
+            lock.unlock()
+            return
+        }
+        lock.unlock()
+        munmap(block, size)
+    }
+
+    /// Unmap every pooled block
+    func drainPool() {
+        lock.lock()
+        let blocks = pool
+        pool.removeAll()
+        pooledBytes = 0
+        lock.unlock()
+
+        for (size, list) in blocks {
+            list.forEach { munmap($0, size) }
+        }
+    }
+
+    /// Zero `byteCount` bytes in tiles spread over the worker threads
+    func zero(_ block: UnsafeMutableRawPointer, byteCount: Int) {
+        let tile = max(pageSize, tileSize / pageSize * pageSize)
+        let tiles = (byteCount + tile - 1) / tile
+        guard tiles > 1 else {
+            memset(block, 0, byteCount)
+            return
+        }
+
+        WorkerPool.shared.concurrentPerform(iterations: tiles) { index in
+            let start = index * tile
+            memset(block + start, 0, min(tile, byteCount - start))
+        }
+    }
+
+    // MARK: - Private Methods
+
+    private func map(_ size: Int) -> UnsafeMutableRawPointer {
+        let failed = UnsafeMutableRawPointer(bitPattern: -1)
+
+        #if arch(x86_64)
+            // VM_FLAGS_SUPERPAGE_SIZE_2MB (SUPERPAGE_SIZE_2MB << VM_FLAGS_SUPERPAGE_SHIFT), passed
+            // in the descriptor slot of an anonymous mapping
+            if size >= superpageSize {
+                let superpage: Int32 = 2 << 16
+                if let block = mmap(nil, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, superpage, 0),
+                    block != failed
+                {
+                    return block
+                }
+            }
+        #endif
+
+        guard let block = mmap(nil, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0),
+            block != failed
+        else {
+            fatalError("GridAllocator: cannot map \(size) bytes")
+        }
+        return block
+    }
+}
+
+/// Page-aligned buffer from `GridAllocator`, returned to the pool when released
+final class GridBuffer<Element> {
+    let count: Int
+    let baseAddress: UnsafeMutablePointer<Element>
+
+    private let byteCount: Int
+
+    /// - Parameter zeroed: Zero the contents; pass false for scratch that is overwritten anyway
+    init(count: Int, zeroed: Bool = true) {
+        precondition(_isPOD(Element.self), "GridBuffer holds trivial element types only")
+        self.count = count
+        byteCount = max(count, 1) * MemoryLayout<Element>.stride
+        baseAddress = GridAllocator.shared.allocate(byteCount: byteCount, zeroed: zeroed)
+            .bindMemory(to: Element.self, capacity: max(count, 1))
+    }
+
+    deinit {
+        GridAllocator.shared.deallocate(UnsafeMutableRawPointer(baseAddress), byteCount: byteCount)
+    }
+}
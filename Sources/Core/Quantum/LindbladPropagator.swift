@@ -0,0 +1,408 @@
+import Accelerate
+import Foundation
+
+/// Mixed state in factored form ρ = Σ_k w_k |ψ_k⟩⟨ψ_k| with orthonormal ψ_k and Σ w_k = 1.
+/// Storage and every operation scale with rank × grid instead of grid².
+struct LowRankDensityMatrix {
+    /// Orthonormal factors (in the grid quadrature), largest weight first
+    var factors: [ComplexArray]
+    /// Eigenvalues of ρ belonging to `factors`
+    var weights: [Double]
+
+    var rank: Int {
+        return factors.count
+    }
+
+    /// Pure state |ψ⟩⟨ψ| (ψ must be normalized)
+    init(pureState: ComplexArray) {
+        self.factors = [pureState]
+        self.weights = [1]
+    }
+
+    init(factors: [ComplexArray], weights: [Double]) {
+        precondition(factors.count == weights.count, "Each factor needs a weight")
+        self.factors = factors
+        self.weights = weights
+    }
+
+    /// Diagonal ρ(x, x) = Σ w_k |ψ_k(x)|²
+    var probabilityDensity: [Double] {
+        guard let first = factors.first else { return [] }
+        var density = [Double](repeating: 0, count: first.count)
+        density.withUnsafeMutableBufferPointer { buffer in
+            let output = buffer.baseAddress!
+            for (factor, weight) in zip(factors, weights) {
+                var w = weight
+                vDSP_vsmaD(factor.probabilityDensity, 1, &w, output, 1, output, 1, vDSP_Length(buffer.count))
+            }
+        }
+        return density
+    }
+
+    /// Tr ρ = Σ w_k
+    var trace: Double {
+        return weights.reduce(0, +)
+    }
+
+    /// Tr ρ² = Σ w_k² (1 for a pure state)
+    var purity: Double {
+        return weights.reduce(0) { $0 + $1 * $1 }
+    }
+}
+
+/// Open-system propagator for the Lindblad equation
+/// dρ/dt = −i[H, ρ]/ħ + Σ_j (L_j ρ L_j† − ½{L_j†L_j, ρ}) on a low-rank factorization of ρ.
+///
+/// A step is the Strang splitting D(dt/2) U(dt) D(dt/2), second order in dt overall:
+/// - U applies the configured coherent propagator to every factor, in parallel;
+/// - D(τ) is the Dyson expansion of the dissipator about the no-jump evolution N(t) = e^{−Γt/2}
+///   (Γ = Σ L_j†L_j) through second order, with the single-jump integral taken at its midpoint:
+///   ρ → N(τ)ρN(τ) + τ Σ_j K_j ρ K_j† + ½τ² Σ_jk L_kL_j ρ (L_kL_j)†,  K_j = N(τ/2) L_j N(τ/2).
+///   Every term is a Kraus branch, so ρ stays positive; each factor ψ_k spawns 1 + J + J²
+///   branches for J channels. The map is trace preserving to O(τ³) per step, and the trace it
+///   actually produces is kept (see `LowRankDensityMatrix.trace`) rather than reset to 1.
+/// After each D the factors are recompressed: the Gram matrix of √w_k ψ_k is diagonalized,
+/// eigenvalues below `truncationTolerance` (relative to the trace) are dropped and at most
+/// `maxRank` are kept; only the weight discarded by truncation is redistributed over the kept
+/// eigenvalues. The rank therefore adapts to how mixed the state actually is, and the cost per
+/// step is O(rank × grid) plus O(rank² × grid) for the Gram matrix.
+final class LindbladPropagator {
+    /// Dissipative channel L
+    enum Channel {
+        /// Position dephasing L = √γ x/ℓ: coherences between x and x′ decay at γ(x − x′)²/2ℓ²
+        case dephasing(rate: Double, length: Double)
+        /// Damping toward the oscillator ground state centred at x = 0: L = √κ a with
+        /// a = (x/σ + σ∂ₓ)/√2, where σ is the oscillator length √(ħ/mω)
+        case damping(rate: Double, length: Double)
+    }
+
+    /// Coherent part of the evolution
+    let unitary: QuantumPropagator
+    let channels: [Channel]
+
+    /// Largest rank kept after recompression
+    var maxRank = 32
+    /// Eigenvalues of ρ below this fraction of the trace are discarded
+    var truncationTolerance = 1e-8
+
+    private let fft: FFTPlan
+
+    var grid: QuantumGrid {
+        return unitary.grid
+    }
+
+    init(unitary: QuantumPropagator, channels: [Channel]) {
+        self.unitary = unitary
+        self.channels = channels
+        self.fft = FFTPlan(count: unitary.grid.count)
+    }
+
+    // MARK: - Propagation
+
+    /// Advance ρ by `steps` Strang steps of size `dt`
+    func propagate(_ rho: inout LowRankDensityMatrix, timeStep dt: Double, steps: Int) {
+        guard steps > 0 else { return }
+        precondition(rho.factors.allSatisfy { $0.count == grid.count }, "Factors do not match propagator grid")
+
+        for _ in 0..<steps {
+            dissipate(&rho, duration: dt / 2)
+
+            rho.factors.withUnsafeMutableBufferPointer { factors in
+                let buffer = factors.baseAddress!
+                WorkerPool.shared.concurrentPerform(iterations: factors.count) { k in
+                    unitary.propagate(&buffer[k], timeStep: dt, steps: 1)
+                }
+            }
+
+            dissipate(&rho, duration: dt / 2)
+        }
+    }
+
+    // MARK: - Private Methods
+
+    /// D(τ) followed by recompression
+    private func dissipate(_ rho: inout LowRankDensityMatrix, duration tau: Double) {
+        guard !channels.isEmpty else { return }
+
+        let rank = rho.rank
+        let jumps = channels.count
+        let branches = 1 + jumps + jumps * jumps
+        var factors = [ComplexArray](repeating: ComplexArray(count: 0), count: rank * branches)
+        var weights = [Double](repeating: 0, count: rank * branches)
+
+        factors.withUnsafeMutableBufferPointer { output in
+            weights.withUnsafeMutableBufferPointer { outputWeights in
+                let factorBuffer = output.baseAddress!
+                let weightBuffer = outputWeights.baseAddress!
+
+                WorkerPool.shared.concurrentPerform(iterations: rank) { k in
+                    let psi = rho.factors[k]
+                    let weight = rho.weights[k]
+                    let first = k * branches
+
+                    // No jump: N(τ)ψ
+                    var survivor = psi
+                    noJump(&survivor, duration: tau)
+                    factorBuffer[first] = survivor
+                    weightBuffer[first] = weight
+
+                    // One jump at the midpoint: N(τ/2) L_j N(τ/2) ψ
+                    var halfway = psi
+                    noJump(&halfway, duration: tau / 2)
+                    for (j, channel) in channels.enumerated() {
+                        var jumped = channel.jump(halfway, on: grid, using: fft)
+                        noJump(&jumped, duration: tau / 2)
+                        factorBuffer[first + 1 + j] = jumped
+                        weightBuffer[first + 1 + j] = weight * tau
+                    }
+
+                    // Two jumps: L_k L_j ψ
+                    for (j, inner) in channels.enumerated() {
+                        let once = inner.jump(psi, on: grid, using: fft)
+                        for (l, outer) in channels.enumerated() {
+                            factorBuffer[first + 1 + jumps + j * jumps + l] = outer.jump(once, on: grid, using: fft)
+                            weightBuffer[first + 1 + jumps + j * jumps + l] = 0.5 * weight * tau * tau
+                        }
+                    }
+                }
+            }
+        }
+
+        rho = recompress(factors: factors, weights: weights)
+    }
+
+    /// ψ ← N(t)ψ = e^{−Γt/2}ψ
+    private func noJump(_ psi: inout ComplexArray, duration t: Double) {
+        channels.noJump(&psi, duration: t, on: grid, using: fft)
+    }
+
+    /// Re-diagonalize Σ w_k |φ_k⟩⟨φ_k| for non-orthogonal φ_k and truncate
+    private func recompress(factors: [ComplexArray], weights: [Double]) -> LowRankDensityMatrix {
+        let count = factors.count
+        let n = grid.count
+        let dx = grid.dx
+        let length = vDSP_Length(n)
+
+        // Gram matrix G_kl = √(w_k w_l) ⟨φ_k|φ_l⟩; its eigenvalues are those of ρ
+        var gramReal = [Double](repeating: 0, count: count * count)
+        var gramImag = [Double](repeating: 0, count: count * count)
+        gramReal.withUnsafeMutableBufferPointer { realBuffer in
+            gramImag.withUnsafeMutableBufferPointer { imagBuffer in
+                let re = realBuffer.baseAddress!
+                let im = imagBuffer.baseAddress!
+                WorkerPool.shared.concurrentPerform(iterations: count) { k in
+                    for l in k..<count {
+                        var rr = 0.0, ii = 0.0, ri = 0.0, ir = 0.0
+                        vDSP_dotprD(factors[k].real, 1, factors[l].real, 1, &rr, length)
+                        vDSP_dotprD(factors[k].imaginary, 1, factors[l].imaginary, 1, &ii, length)
+                        vDSP_dotprD(factors[k].real, 1, factors[l].imaginary, 1, &ri, length)
+                        vDSP_dotprD(factors[k].imaginary, 1, factors[l].real, 1, &ir, length)
+
+                        let scale = sqrt(weights[k] * weights[l]) * dx
+                        re[k * count + l] = scale * (rr + ii)
+                        im[k * count + l] = scale * (ri - ir)
+                        re[l * count + k] = scale * (rr + ii)
+                        im[l * count + k] = -scale * (ri - ir)
+                    }
+                }
+            }
+        }
+
+        let eigen = LindbladPropagator.hermitianEigensystem(real: gramReal, imaginary: gramImag, size: count)
+
+        // Keep the dominant eigenvalues
+        let trace = eigen.values.reduce(0) { $0 + max($1, 0) }
+        let order = eigen.values.indices.sorted { eigen.values[$0] > eigen.values[$1] }
+        let kept = order.prefix(maxRank).filter { eigen.values[$0] > truncationTolerance * trace }
+        // Truncated weight goes back to the kept eigenvalues; the dissipator's own trace is kept
+        let keptTrace = kept.reduce(0) { $0 + eigen.values[$1] }
+        let restore = keptTrace > 0 ? trace / keptTrace : 0
+
+        // New factor m: Σ_k v_km √w_k φ_k / √λ_m
+        var newFactors = [ComplexArray](repeating: ComplexArray(count: 0), count: kept.count)
+        newFactors.withUnsafeMutableBufferPointer { output in
+            let buffer = output.baseAddress!
+            WorkerPool.shared.concurrentPerform(iterations: kept.count) { index in
+                let m = kept[index]
+                var factor = ComplexArray(count: n)
+                let norm = 1 / sqrt(eigen.values[m])
+                factor.real.withUnsafeMutableBufferPointer { realBuffer in
+                    factor.imaginary.withUnsafeMutableBufferPointer { imagBuffer in
+                        let re = realBuffer.baseAddress!
+                        let im = imagBuffer.baseAddress!
+                        for k in 0..<count {
+                            // (a + ib)(φ_re + iφ_im) accumulated into the factor
+                            let scale = sqrt(weights[k]) * norm
+                            var a = scale * eigen.vectorsReal[k * count + m]
+                            var b = scale * eigen.vectorsImag[k * count + m]
+                            var negativeB = -b
+                            vDSP_vsmaD(factors[k].real, 1, &a, re, 1, re, 1, length)
+                            vDSP_vsmaD(factors[k].imaginary, 1, &negativeB, re, 1, re, 1, length)
+                            vDSP_vsmaD(factors[k].imaginary, 1, &a, im, 1, im, 1, length)
+                            vDSP_vsmaD(factors[k].real, 1, &b, im, 1, im, 1, length)
+                        }
+                    }
+                }
+                buffer[index] = factor
+            }
+        }
+
+        return LowRankDensityMatrix(factors: newFactors, weights: kept.map { eigen.values[$0] * restore })
+    }
+
+    /// Eigen-decomposition of a small Hermitian matrix (row-major) by cyclic complex Jacobi
+    /// rotations. Column m of the returned vectors belongs to `values[m]`.
+    static func hermitianEigensystem(real: [Double], imaginary: [Double], size n: Int)
+        -> (values: [Double], vectorsReal: [Double], vectorsImag: [Double])
+    {
+        var ar = real
+        var ai = imaginary
+        var vr = [Double](repeating: 0, count: n * n)
+        var vi = [Double](repeating: 0, count: n * n)
+        for k in 0..<n {
+            vr[k * n + k] = 1
+        }
+
+        // (x_i, x_j) ← (c x_i − s x_j, s x_i + c x_j)
+        func rotate(_ x: inout [Double], _ i: Int, _ j: Int, _ c: Double, _ s: Double) {
+            (x[i], x[j]) = (c * x[i] - s * x[j], s * x[i] + c * x[j])
+        }
+
+        // (re, im)[i] ← (re, im)[i] · (c + is)
+        func phase(_ re: inout [Double], _ im: inout [Double], _ i: Int, _ c: Double, _ s: Double) {
+            (re[i], im[i]) = (re[i] * c - im[i] * s, re[i] * s + im[i] * c)
+        }
+
+        let total = ar.reduce(0) { $0 + $1 * $1 } + ai.reduce(0) { $0 + $1 * $1 }
+        for _ in 0..<50 {
+            var offDiagonal = 0.0
+            for p in 0..<n {
+                for q in (p + 1)..<n {
+                    offDiagonal += ar[p * n + q] * ar[p * n + q] + ai[p * n + q] * ai[p * n + q]
+                }
+            }
+            if offDiagonal <= 1e-28 * total { break }
+
+            for p in 0..<n {
+                for q in (p + 1)..<n {
+                    let magnitude = hypot(ar[p * n + q], ai[p * n + q])
+                    if magnitude == 0 { continue }
+
+                    // Unitary diagonal similarity: column q times e^{−iφ}, row q times e^{iφ},
+                    // so that A_pq = |A_pq| e^{iφ} becomes real
+                    let c = ar[p * n + q] / magnitude
+                    let s = ai[p * n + q] / magnitude
+                    for k in 0..<n {
+                        phase(&ar, &ai, k * n + q, c, -s)
+                        phase(&ar, &ai, q * n + k, c, s)
+                        phase(&vr, &vi, k * n + q, c, -s)
+                    }
+
+                    // Real Jacobi rotation zeroing A_pq
+                    let tau = (ar[q * n + q] - ar[p * n + p]) / (2 * magnitude)
+                    let t = (tau >= 0 ? 1.0 : -1.0) / (abs(tau) + sqrt(1 + tau * tau))
+                    let cosine = 1 / sqrt(1 + t * t)
+                    let sine = t * cosine
+                    for k in 0..<n {
+                        rotate(&ar, k * n + p, k * n + q, cosine, sine)
+                        rotate(&ai, k * n + p, k * n + q, cosine, sine)
+                        rotate(&vr, k * n + p, k * n + q, cosine, sine)
+                        rotate(&vi, k * n + p, k * n + q, cosine, sine)
+                    }
+                    for k in 0..<n {
+                        rotate(&ar, p * n + k, q * n + k, cosine, sine)
+                        rotate(&ai, p * n + k, q * n + k, cosine, sine)
+                    }
+                }
+            }
+        }
+
+        return ((0..<n).map { ar[$0 * n + $0] }, vr, vi)
+    }
+}
+
+extension Array where Element == LindbladPropagator.Channel {
+    /// ψ ← N(t)ψ = e^{−Γt/2}ψ, with the channels' decays composed symmetrically so that
+    /// non-commuting Γ_j stay second order
+    func noJump(_ psi: inout ComplexArray, duration t: Double, on grid: QuantumGrid, using fft: FFTPlan) {
+        guard let last = last else { return }
+        let outer = dropLast()
+        for channel in outer {
+            channel.decay(&psi, duration: t / 2, on: grid, using: fft)
+        }
+        last.decay(&psi, duration: t, on: grid, using: fft)
+        for channel in outer.reversed() {
+            channel.decay(&psi, duration: t / 2, on: grid, using: fft)
+        }
+    }
+}
+
+extension LindbladPropagator.Channel {
+    /// L ψ
+    func jump(_ psi: ComplexArray, on grid: QuantumGrid, using fft: FFTPlan) -> ComplexArray {
+        let n = grid.count
+        var result = ComplexArray(count: n)
+
+        switch self {
+        case .dephasing(let rate, let length):
+            let scale = grid.positions.map { sqrt(rate) * $0 / length }
+            vDSP_vmulD(psi.real, 1, scale, 1, &result.real, 1, vDSP_Length(n))
+            vDSP_vmulD(psi.imaginary, 1, scale, 1, &result.imaginary, 1, vDSP_Length(n))
+
+        case .damping(let rate, let length):
+            // σ∂ₓψ spectrally: F⁻¹ (iσk/N) F ψ
+            var derivative = psi
+            let waveNumbers = grid.waveNumbers
+            derivative.withSplitComplex { fft.forward($0) }
+            for j in 0..<n {
+                let factor = length * waveNumbers[j] / Double(n)
+                (derivative.real[j], derivative.imaginary[j]) =
+                    (-factor * derivative.imaginary[j], factor * derivative.real[j])
+            }
+            derivative.withSplitComplex { fft.inverse($0) }
+
+            let amplitude = sqrt(rate / 2)
+            let positions = grid.positions
+            for j in 0..<n {
+                let position = positions[j] / length
+                result.real[j] = amplitude * (position * psi.real[j] + derivative.real[j])
+                result.imaginary[j] = amplitude * (position * psi.imaginary[j] + derivative.imaginary[j])
+            }
+        }
+
+        return result
+    }
+
+    /// No-jump evolution ψ ← e^{−L†L τ/2} ψ
+    func decay(_ psi: inout ComplexArray, duration tau: Double, on grid: QuantumGrid, using fft: FFTPlan) {
+        let n = grid.count
+        let length = vDSP_Length(n)
+
+        func multiply(_ psi: inout ComplexArray, by factor: [Double]) {
+            psi.real.withUnsafeMutableBufferPointer { vDSP_vmulD($0.baseAddress!, 1, factor, 1, $0.baseAddress!, 1, length) }
+            psi.imaginary.withUnsafeMutableBufferPointer {
+                vDSP_vmulD($0.baseAddress!, 1, factor, 1, $0.baseAddress!, 1, length)
+            }
+        }
+
+        switch self {
+        case .dephasing(let rate, let scale):
+            // L†L = γx²/ℓ² is diagonal, so the decay is exact
+            multiply(&psi, by: grid.positions.map { exp(-0.5 * tau * rate * $0 * $0 / (scale * scale)) })
+
+        case .damping(let rate, let scale):
+            // L†L = κ(−σ²∂²/2 + x²/2σ² − ½): an imaginary-time oscillator step, split like the
+            // real-time split-operator step so high-k components decay instead of blowing up
+            let halfPotential = grid.positions.map {
+                exp(-0.25 * tau * rate * $0 * $0 / (2 * scale * scale) + 0.125 * tau * rate)
+            }
+            let kinetic = grid.waveNumbers.map { exp(-0.5 * tau * rate * scale * scale * $0 * $0 / 2) / Double(n) }
+
+            multiply(&psi, by: halfPotential)
+            psi.withSplitComplex { fft.forward($0) }
+            multiply(&psi, by: kinetic)
+            psi.withSplitComplex { fft.inverse($0) }
+            multiply(&psi, by: halfPotential)
+        }
+    }
+}
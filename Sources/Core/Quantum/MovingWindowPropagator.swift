@@ -0,0 +1,203 @@
+import Accelerate
+import Foundation
+
+/// Adaptive moving-window propagator for localized wave packets.
+///
+/// Only the part of the lab grid where |ψ|² exceeds a relative threshold, plus margins, is
+/// stored and propagated. The window follows the density centroid and is resized when the
+/// packet spreads, so per-step cost scales with the packet extent instead of the domain size.
+/// Recentering shifts the window by whole lab cells, so it is a plain copy with no
+/// interpolation error. Between adaptations each margin (at most 1/8 of the window) is an
+/// absorbing layer, so density that reaches a window edge is removed rather than wrapped to the
+/// other side. Both that and any density falling outside a new window are accumulated in
+/// `State.lostNorm`. Once the loss exceeds the budget, the run's margins double
+/// at every adaptation, so the window widens toward the full lab grid instead of losing more.
+final class MovingWindowPropagator {
+    /// Window tuning parameters
+    struct Configuration {
+        /// Cells whose density is below this fraction of the peak are considered empty
+        var densityThreshold: Double = 1e-10
+        /// Extra cells kept on each side of the occupied region at the start of a run. The margins
+        /// are also the absorbing layers, which need to span at least a carrier wavelength.
+        var marginCells: Int = 128
+        /// Smallest window size (a power of two)
+        var minimumWindowCount: Int = 64
+        /// Steps between window adaptations
+        var adaptationInterval: Int = 16
+        /// Total norm loss tolerated per run before margins are widened
+        var normLossBudget: Double = 1e-6
+    }
+
+    /// Windowed wave function and its placement on the lab grid
+    struct State {
+        /// Samples of ψ inside the window
+        var window: ComplexArray
+        /// Lab-grid index of the first window sample
+        var startIndex: Int
+        /// Simulation time in seconds
+        var time: Double = 0
+        /// Integrated norm absorbed at the window edges or discarded by recentering so far
+        var lostNorm: Double = 0
+        /// Margin on each side of the occupied region, widened when `lostNorm` exceeds the budget
+        var marginCells: Int
+
+        /// Number of lab cells currently simulated
+        var windowCount: Int {
+            return window.count
+        }
+    }
+
+    let labGrid: QuantumGrid
+    let mass: Double
+    let potential: [Double]
+    let configuration: Configuration
+
+    // Propagators are rebuilt only when the window moves; FFT plans are reused per size
+    private var fftPlans: [Int: FFTPlan] = [:]
+    private var cachedPropagator: (startIndex: Int, propagator: SplitOperatorPropagator)?
+    private var cachedEdges: (count: Int, layerCells: Int, edges: AbsorbingEdges)?
+
+    /// - Parameters:
+    ///   - labGrid: Full simulation domain
+    ///   - mass: Particle mass in kg
+    ///   - potential: Potential energy in Joules on the lab grid
+    init(labGrid: QuantumGrid, mass: Double, potential: [Double], configuration: Configuration = Configuration()) {
+        precondition(potential.count == labGrid.count, "Potential must match lab grid size")
+        self.labGrid = labGrid
+        self.mass = mass
+        self.potential = potential
+        self.configuration = configuration
+    }
+
+    // MARK: - Conversion
+
+    /// Crop a full lab-grid wave function to its occupied window
+    func makeState(from psi: ComplexArray, time: Double = 0) -> State {
+        precondition(psi.count == labGrid.count, "State does not match lab grid")
+        var state = State(window: psi, startIndex: 0, time: time, marginCells: configuration.marginCells)
+        adaptWindow(&state)
+        return state
+    }
+
+    /// Reconstruct ψ on the full lab grid (zero outside the window)
+    func reconstructWaveFunction(_ state: State) -> ComplexArray {
+        var psi = ComplexArray(count: labGrid.count)
+        let range = state.startIndex..<(state.startIndex + state.windowCount)
+        psi.real.replaceSubrange(range, with: state.window.real)
+        psi.imaginary.replaceSubrange(range, with: state.window.imaginary)
+        return psi
+    }
+
+    // MARK: - Propagation
+
+    /// Advance by `steps` steps of size `dt`, adapting the window every `adaptationInterval` steps
+    func propagate(_ state: inout State, timeStep dt: Double, steps: Int) {
+        var remaining = steps
+
+        while remaining > 0 {
+            let chunk = min(remaining, max(1, configuration.adaptationInterval))
+            state.lostNorm += propagator(for: state).propagate(
+                &state.window, timeStep: dt, steps: chunk, absorbing: edges(for: state))
+            state.time += dt * Double(chunk)
+            remaining -= chunk
+
+            adaptWindow(&state)
+        }
+    }
+
+    // MARK: - Window Management
+
+    /// Recenter and resize the window around the occupied region
+    private func adaptWindow(_ state: inout State) {
+        let density = state.window.probabilityDensity
+        guard !density.isEmpty else { return }
+
+        var peak = 0.0
+        vDSP_maxvD(density, 1, &peak, vDSP_Length(density.count))
+        guard peak > 0 else { return }
+
+        // Occupied region and centroid in window coordinates
+        let cutoff = peak * configuration.densityThreshold
+        guard let first = density.firstIndex(where: { $0 > cutoff }),
+            let last = density.lastIndex(where: { $0 > cutoff })
+        else { return }
+
+        let indices = (0..<density.count).map { Double($0) }
+        var weighted = 0.0
+        var total = 0.0
+        vDSP_dotprD(indices, 1, density, 1, &weighted, vDSP_Length(density.count))
+        vDSP_sveD(density, 1, &total, vDSP_Length(density.count))
+        let centroid = state.startIndex + Int((weighted / total).rounded())
+
+        // Keep the loss bounded: once the budget is spent, widen this run's margins
+        if state.lostNorm > configuration.normLossBudget {
+            state.marginCells = min(2 * state.marginCells, labGrid.count)
+        }
+
+        // Smallest power-of-two window that covers the occupied region plus margins
+        let largestWindow = 1 << (Int.bitWidth - 1 - labGrid.count.leadingZeroBitCount)
+        let required = last - first + 1 + 2 * state.marginCells
+        var count = max(configuration.minimumWindowCount, 1)
+        while count < required && count < largestWindow {
+            count <<= 1
+        }
+        count = min(count, largestWindow)
+
+        let start = min(max(centroid - count / 2, 0), labGrid.count - count)
+        guard start != state.startIndex || count != state.windowCount else { return }
+
+        // Copy the overlap; everything else is either new empty space or discarded
+        var window = ComplexArray(count: count)
+        let overlapStart = max(start, state.startIndex)
+        let overlapEnd = min(start + count, state.startIndex + state.windowCount)
+        var keptSum = 0.0
+        if overlapStart < overlapEnd {
+            let source = (overlapStart - state.startIndex)..<(overlapEnd - state.startIndex)
+            let destination = (overlapStart - start)..<(overlapEnd - start)
+            window.real.replaceSubrange(destination, with: state.window.real[source])
+            window.imaginary.replaceSubrange(destination, with: state.window.imaginary[source])
+            keptSum = window.squaredMagnitudeSum
+        }
+
+        state.lostNorm += max(0, total - keptSum) * labGrid.dx
+        state.window = window
+        state.startIndex = start
+    }
+
+    /// Absorbing layers covering the margins of the current window
+    private func edges(for state: State) -> AbsorbingEdges {
+        let layerCells = max(1, min(state.marginCells, state.windowCount / 8))
+        if let cached = cachedEdges, cached.count == state.windowCount, cached.layerCells == layerCells {
+            return cached.edges
+        }
+
+        let edges = AbsorbingEdges(count: state.windowCount, layerCells: layerCells)
+        cachedEdges = (state.windowCount, layerCells, edges)
+        return edges
+    }
+
+    /// Split-operator propagator for the current window placement
+    private func propagator(for state: State) -> SplitOperatorPropagator {
+        if let cached = cachedPropagator, cached.startIndex == state.startIndex,
+            cached.propagator.grid.count == state.windowCount
+        {
+            return cached.propagator
+        }
+
+        let count = state.windowCount
+        let plan = fftPlans[count] ?? FFTPlan(count: count)
+        fftPlans[count] = plan
+
+        let grid = QuantumGrid(
+            xMin: labGrid.position(at: state.startIndex),
+            xMax: labGrid.position(at: state.startIndex + count),
+            count: count)
+        let propagator = SplitOperatorPropagator(
+            grid: grid, mass: mass,
+            potential: Array(potential[state.startIndex..<(state.startIndex + count)]),
+            fft: plan)
+
+        cachedPropagator = (state.startIndex, propagator)
+        return propagator
+    }
+}
@@ -0,0 +1,331 @@
+import Accelerate
+import Foundation
+
+/// Gradient (GRAPE) optimizer for piecewise-constant controls of
+/// V(x, t) = V₀(x) + Σ_k u_k(t) S_k(x) that maximize the transfer fidelity F = |⟨χ|ψ(T)⟩|².
+///
+/// Each of the `sliceCount` slices is one Strang step U_n = P_n K P_n with the diagonal
+/// P_n = e^{−iV_n dt/2ħ}, so ∂U_n/∂u_{n,k} = −(i dt/2ħ)(S_k U_n + U_n S_k). With the adjoint
+/// λ_n = U_n†⋯U_{N−1}† χ this gives the exact gradient of the discretized dynamics,
+/// ∂⟨χ|ψ_N⟩/∂u_{n,k} = −(i dt/2ħ)(⟨λ_{n+1}|S_k|ψ_{n+1}⟩ + ⟨λ_n|S_k|ψ_n⟩),
+/// from the forward state and adjoint at slice boundaries only.
+///
+/// The adjoint sweep runs backwards and needs the forward states in reverse order. Rather than
+/// storing all N of them, binomial (revolve) checkpointing keeps at most `snapshotCount` and
+/// recomputes the rest: s snapshots and t recomputation sweeps reverse β(s, t) = C(s + t, s)
+/// slices, so a gradient costs a few forward runs in O(s · grid) memory. The step lengths of
+/// each line search are independent forward runs and are evaluated concurrently.
+final class OptimalControlOptimizer {
+    struct Configuration {
+        /// Gradient iterations
+        var iterations = 50
+        /// Largest change of any control amplitude in the first line search
+        var initialStepSize = 1.0
+        /// Forward states kept by the checkpointed adjoint sweep
+        var snapshotCount = 16
+        /// Step lengths tried per line search: α·2^j for j = −1 … candidates − 2
+        var lineSearchCandidates = 4
+        /// Stop once the fidelity reaches this value
+        var targetFidelity = 0.999
+    }
+
+    struct Result {
+        /// Optimized amplitudes; controls[n · profiles.count + k] drives profile k in slice n
+        let controls: [Double]
+        /// Fidelity before the first and after every iteration
+        let fidelities: [Double]
+    }
+
+    let grid: QuantumGrid
+    let mass: Double
+    /// V₀(x) in Joules
+    let staticPotential: [Double]
+    /// Control profiles S_k(x) in Joules per unit amplitude
+    let profiles: [[Double]]
+    let duration: Double
+    let sliceCount: Int
+    var configuration: Configuration
+
+    private let hBar = QuantumMath.reducedPlanckConstant
+    private let fft: FFTPlan
+    private let forwardKinetic: ComplexArray
+    private let backwardKinetic: ComplexArray
+
+    /// Length of one control slice
+    var timeStep: Double {
+        return duration / Double(sliceCount)
+    }
+
+    /// Number of control amplitudes (slices × profiles)
+    var controlCount: Int {
+        return sliceCount * profiles.count
+    }
+
+    init(
+        grid: QuantumGrid, mass: Double, staticPotential: [Double], profiles: [[Double]], duration: Double,
+        sliceCount: Int, configuration: Configuration = Configuration()
+    ) {
+        precondition(staticPotential.count == grid.count, "Potential must match grid size")
+        precondition(profiles.allSatisfy { $0.count == grid.count }, "Profiles must match grid size")
+        precondition(sliceCount > 0, "At least one control slice is required")
+        self.grid = grid
+        self.mass = mass
+        self.staticPotential = staticPotential
+        self.profiles = profiles
+        self.duration = duration
+        self.sliceCount = sliceCount
+        self.configuration = configuration
+        self.fft = FFTPlan(count: grid.count)
+
+        let dt = duration / Double(sliceCount)
+        let angles = grid.waveNumbers.map { -QuantumMath.reducedPlanckConstant * $0 * $0 * dt / (2 * mass) }
+        self.forwardKinetic = FFTPlan.phaseTable(angles: angles, scale: 1.0 / Double(grid.count))
+        self.backwardKinetic = FFTPlan.phaseTable(angles: angles.map { -$0 }, scale: 1.0 / Double(grid.count))
+    }
+
+    /// |⟨target|ψ(T)⟩|² after one forward run under `controls`
+    func fidelity(controls: [Double], from initial: ComplexArray, to target: ComplexArray) -> Double {
+        precondition(controls.count == controlCount, "Controls must hold one amplitude per slice and profile")
+        var workspace = Workspace(count: grid.count)
+        var psi = initial
+        for slice in 0..<sliceCount {
+            step(&psi, slice: slice, controls: controls, backward: false, workspace: &workspace)
+        }
+        let overlap = innerProduct(target, psi)
+        return overlap.real * overlap.real + overlap.imaginary * overlap.imaginary
+    }
+
+    /// Fidelity and its exact gradient with respect to every control amplitude
+    func gradient(controls: [Double], from initial: ComplexArray, to target: ComplexArray)
+        -> (fidelity: Double, gradient: [Double])
+    {
+        precondition(controls.count == controlCount, "Controls must hold one amplitude per slice and profile")
+        precondition(initial.count == grid.count && target.count == grid.count, "States must match the grid")
+
+        var sweep = AdjointSweep(
+            controls: controls, terms: [Complex](repeating: Complex(), count: controlCount),
+            workspace: Workspace(count: grid.count))
+        var adjoint = target
+        reverse(initial, slices: 0..<sliceCount, snapshots: max(0, configuration.snapshotCount), adjoint: &adjoint,
+                sweep: &sweep)
+
+        // Unitarity makes ⟨λ_0|ψ_0⟩ = ⟨χ|ψ_N⟩
+        let overlap = innerProduct(adjoint, initial)
+        let factor = timeStep / hBar
+        let gradient = sweep.terms.map {
+            factor * (overlap.real * $0.imaginary - overlap.imaginary * $0.real)
+        }
+        return (overlap.real * overlap.real + overlap.imaginary * overlap.imaginary, gradient)
+    }
+
+    /// Gradient ascent from `initialControls` (zero if nil) with a parallel line search
+    /// - Parameter cancellation: Checked before each iteration; the best controls so far are returned
+    func optimize(
+        from initial: ComplexArray, to target: ComplexArray, initialControls: [Double]? = nil,
+        cancellation: CancellationToken? = nil
+    ) -> Result {
+        var controls = initialControls ?? [Double](repeating: 0, count: controlCount)
+        var stepSize = configuration.initialStepSize
+        let candidates = max(1, configuration.lineSearchCandidates)
+
+        var (current, slope) = gradient(controls: controls, from: initial, to: target)
+        var fidelities = [current]
+
+        for _ in 0..<configuration.iterations where current < configuration.targetFidelity {
+            if cancellation?.isCancelled == true {
+                break
+            }
+            let largest = slope.reduce(0) { max($0, abs($1)) }
+            guard largest > 0 else { break }
+            let direction = slope.map { $0 / largest }
+
+            // Independent forward runs, one per trial step length
+            let lengths = (0..<candidates).map { stepSize * pow(2, Double($0 - 1)) }
+            var trials = [Double](repeating: 0, count: candidates)
+            trials.withUnsafeMutableBufferPointer { buffer in
+                let output = buffer.baseAddress!
+                WorkerPool.shared.concurrentPerform(iterations: candidates) { index in
+                    let trial = zip(controls, direction).map { $0 + lengths[index] * $1 }
+                    output[index] = fidelity(controls: trial, from: initial, to: target)
+                }
+            }
+
+            let best = trials.indices.max { trials[$0] < trials[$1] }!
+            if trials[best] > current {
+                controls = zip(controls, direction).map { $0 + lengths[best] * $1 }
+                stepSize = lengths[best]
+                (current, slope) = gradient(controls: controls, from: initial, to: target)
+            } else {
+                stepSize = lengths[0] / 2
+            }
+            fidelities.append(current)
+        }
+
+        return Result(controls: controls, fidelities: fidelities)
+    }
+
+    // MARK: - Private Methods
+
+    /// Buffers reused for every step of one run
+    private struct Workspace {
+        var effective: [Double]
+        var angles: [Double]
+        var phase: ComplexArray
+        // Re and Im of λ*ψ per grid point
+        var productReal: [Double]
+        var productImaginary: [Double]
+
+        init(count: Int) {
+            effective = [Double](repeating: 0, count: count)
+            angles = [Double](repeating: 0, count: count)
+            phase = ComplexArray(count: count)
+            productReal = [Double](repeating: 0, count: count)
+            productImaginary = [Double](repeating: 0, count: count)
+        }
+    }
+
+    /// State carried through the checkpointed reverse sweep
+    private struct AdjointSweep {
+        let controls: [Double]
+        /// ⟨λ_{n+1}|S_k|ψ_{n+1}⟩ + ⟨λ_n|S_k|ψ_n⟩ per control
+        var terms: [Complex]
+        var workspace: Workspace
+    }
+
+    /// Run the adjoint from the end of `slices` to its start given the forward state at the start.
+    /// Revolve: advance to a checkpoint, reverse the right part with one snapshot fewer, then
+    /// reverse the left part again from `start`.
+    private func reverse(
+        _ start: ComplexArray, slices: Range<Int>, snapshots: Int, adjoint: inout ComplexArray,
+        sweep: inout AdjointSweep
+    ) {
+        let length = slices.count
+        guard length > 1 else {
+            if length == 1 {
+                reverseSlice(start, slice: slices.lowerBound, adjoint: &adjoint, sweep: &sweep)
+            }
+            return
+        }
+
+        guard snapshots > 0 else {
+            // No memory left: recompute each state from `start`
+            for slice in slices.reversed() {
+                var psi = start
+                for earlier in slices.lowerBound..<slice {
+                    step(&psi, slice: earlier, controls: sweep.controls, backward: false, workspace: &sweep.workspace)
+                }
+                reverseSlice(psi, slice: slice, adjoint: &adjoint, sweep: &sweep)
+            }
+            return
+        }
+
+        // Smallest t with β(s, t) ≥ length; the checkpoint goes β(s, t − 1) slices ahead
+        var sweeps = 1
+        while OptimalControlOptimizer.binomial(snapshots + sweeps, snapshots) < length {
+            sweeps += 1
+        }
+        let split = slices.lowerBound
+            + min(max(OptimalControlOptimizer.binomial(snapshots + sweeps - 1, snapshots), 1), length - 1)
+
+        var checkpoint = start
+        for slice in slices.lowerBound..<split {
+            step(&checkpoint, slice: slice, controls: sweep.controls, backward: false, workspace: &sweep.workspace)
+        }
+        reverse(checkpoint, slices: split..<slices.upperBound, snapshots: snapshots - 1, adjoint: &adjoint,
+                sweep: &sweep)
+        reverse(start, slices: slices.lowerBound..<split, snapshots: snapshots, adjoint: &adjoint, sweep: &sweep)
+    }
+
+    /// Gradient terms of one slice: λ_{n+1} → λ_n given ψ_n
+    private func reverseSlice(_ psi: ComplexArray, slice: Int, adjoint: inout ComplexArray, sweep: inout AdjointSweep) {
+        var next = psi
+        step(&next, slice: slice, controls: sweep.controls, backward: false, workspace: &sweep.workspace)
+        accumulate(adjoint, next, slice: slice, sweep: &sweep)
+
+        step(&adjoint, slice: slice, controls: sweep.controls, backward: true, workspace: &sweep.workspace)
+        accumulate(adjoint, psi, slice: slice, sweep: &sweep)
+    }
+
+    /// terms[n, k] += ⟨λ|S_k|ψ⟩
+    private func accumulate(_ adjoint: ComplexArray, _ psi: ComplexArray, slice: Int, sweep: inout AdjointSweep) {
+        let length = vDSP_Length(grid.count)
+        vDSP_vmmaD(
+            adjoint.real, 1, psi.real, 1, adjoint.imaginary, 1, psi.imaginary, 1,
+            &sweep.workspace.productReal, 1, length)
+        vDSP_vmmsbD(
+            adjoint.real, 1, psi.imaginary, 1, adjoint.imaginary, 1, psi.real, 1,
+            &sweep.workspace.productImaginary, 1, length)
+
+        for (k, profile) in profiles.enumerated() {
+            var real = 0.0
+            var imaginary = 0.0
+            vDSP_dotprD(profile, 1, sweep.workspace.productReal, 1, &real, length)
+            vDSP_dotprD(profile, 1, sweep.workspace.productImaginary, 1, &imaginary, length)
+            sweep.terms[slice * profiles.count + k] =
+                sweep.terms[slice * profiles.count + k] + Complex(real: real * grid.dx, imaginary: imaginary * grid.dx)
+        }
+    }
+
+    /// ψ ← U_n ψ, or U_n† ψ when `backward`
+    private func step(
+        _ psi: inout ComplexArray, slice: Int, controls: [Double], backward: Bool, workspace: inout Workspace
+    ) {
+        let length = vDSP_Length(grid.count)
+        var count = Int32(grid.count)
+
+        var one = 1.0
+        vDSP_vsmulD(staticPotential, 1, &one, &workspace.effective, 1, length)
+        workspace.effective.withUnsafeMutableBufferPointer { buffer in
+            let values = buffer.baseAddress!
+            for (k, profile) in profiles.enumerated() {
+                var amplitude = controls[slice * profiles.count + k]
+                guard amplitude != 0 else { continue }
+                vDSP_vsmaD(profile, 1, &amplitude, values, 1, values, 1, length)
+            }
+        }
+
+        var scale = (backward ? 1 : -1) * timeStep / (2 * hBar)
+        vDSP_vsmulD(workspace.effective, 1, &scale, &workspace.angles, 1, length)
+        vvsincos(&workspace.phase.imaginary, &workspace.phase.real, workspace.angles, &count)
+
+        // The kinetic tables are shared by concurrent runs and only ever read
+        let table = backward ? backwardKinetic : forwardKinetic
+        table.real.withUnsafeBufferPointer { kineticReal in
+            table.imaginary.withUnsafeBufferPointer { kineticImaginary in
+                var kinetic = DSPDoubleSplitComplex(
+                    realp: UnsafeMutablePointer(mutating: kineticReal.baseAddress!),
+                    imagp: UnsafeMutablePointer(mutating: kineticImaginary.baseAddress!))
+
+                workspace.phase.withSplitComplex { phase in
+                    psi.withSplitComplex { state in
+                        vDSP_zvmulD(state, 1, phase, 1, state, 1, length, 1)
+                        fft.forward(state)
+                        vDSP_zvmulD(state, 1, &kinetic, 1, state, 1, length, 1)
+                        fft.inverse(state)
+                        vDSP_zvmulD(state, 1, phase, 1, state, 1, length, 1)
+                    }
+                }
+            }
+        }
+    }
+
+    /// ⟨a|b⟩ = Σ a* b dx
+    private func innerProduct(_ a: ComplexArray, _ b: ComplexArray) -> Complex {
+        let length = vDSP_Length(grid.count)
+        var rr = 0.0, ii = 0.0, ri = 0.0, ir = 0.0
+        vDSP_dotprD(a.real, 1, b.real, 1, &rr, length)
+        vDSP_dotprD(a.imaginary, 1, b.imaginary, 1, &ii, length)
+        vDSP_dotprD(a.real, 1, b.imaginary, 1, &ri, length)
+        vDSP_dotprD(a.imaginary, 1, b.real, 1, &ir, length)
+        return Complex(real: (rr + ii) * grid.dx, imaginary: (ri - ir) * grid.dx)
+    }
+
+    /// C(n, k) without overflow for the small arguments used by the checkpoint schedule
+    private static func binomial(_ n: Int, _ k: Int) -> Int {
+        var result = 1
+        for i in 0..<min(k, n - k) {
+            result = result * (n - i) / (i + 1)
+        }
+        return result
+    }
+}
@@ -0,0 +1,227 @@
+import Accelerate
+import Foundation
+
+/// Definite parity of a wave function about a mirror point
+enum Parity {
+    case even
+    case odd
+
+    /// Sign relating ψ(c - x) to ψ(c + x)
+    var sign: Double {
+        switch self {
+        case .even: return 1
+        case .odd: return -1
+        }
+    }
+
+    /// Detect the parity of `psi` about `center`, or nil if it has none within `tolerance`
+    /// (relative L2 mismatch between the state and its mirror image).
+    static func detect(_ psi: ComplexArray, on grid: QuantumGrid, center: Double, tolerance: Double = 1e-6)
+        -> Parity?
+    {
+        let norm = sqrt(psi.squaredMagnitudeSum)
+        guard norm > 0 else { return nil }
+
+        var evenMismatch = 0.0
+        var oddMismatch = 0.0
+        for i in 0..<grid.count {
+            let value = psi[i]
+            let mirrored = psi.sample(at: 2 * center - grid.position(at: i), on: grid)
+            evenMismatch += (value - mirrored).absoluteSquared
+            oddMismatch += (value + mirrored).absoluteSquared
+        }
+
+        if sqrt(evenMismatch) / norm < tolerance { return .even }
+        if sqrt(oddMismatch) / norm < tolerance { return .odd }
+        return nil
+    }
+}
+
+extension QuantumGrid {
+    /// `count` points at c + (j + ½)dx for j = -count/2 ..< count/2, spanning c ± halfWidth.
+    /// Points pair up under x → 2c - x, and the right half is the grid of a mirror-reduced
+    /// engine with the same spacing.
+    static func mirrorSymmetric(center: Double, halfWidth: Double, count: Int) -> QuantumGrid {
+        let dx = 2 * halfWidth / Double(count)
+        return QuantumGrid(xMin: center - halfWidth + dx / 2, xMax: center + halfWidth + dx / 2, count: count)
+    }
+
+    /// The x ≥ c half of `mirrorSymmetric`: `count` points at c + (j + ½)dx
+    static func mirrorReduced(center: Double, halfWidth: Double, count: Int) -> QuantumGrid {
+        let dx = halfWidth / Double(count)
+        return QuantumGrid(xMin: center + dx / 2, xMax: center + halfWidth + dx / 2, count: count)
+    }
+}
+
+/// Split-operator propagator restricted to one half of a mirror-symmetric problem.
+///
+/// For V(c + x) = V(c - x) and a state of definite parity, only x ≥ c is stored. The reduced
+/// grid samples c + (j + ½)dx, so the even sector is diagonalized by a DCT-II (Neumann at
+/// the mirror) and the odd sector by a DST-II (Dirichlet at the mirror). Both transforms are
+/// evaluated with one complex FFT of the reduced length M (Makhoul's reordering) instead of
+/// one of length 2M; the reordering and twiddle passes around it are scalar loops. The full
+/// field is rebuilt lazily for display.
+final class ParityReducedPropagator: QuantumPropagator {
+    /// Reduced grid of M points at c + (j + ½)dx
+    let grid: QuantumGrid
+    /// Mirror point c
+    let center: Double
+    let parity: Parity
+    let mass: Double
+    /// Potential energy in Joules on the reduced grid
+    let potential: [Double]
+
+    private let hBar = QuantumMath.reducedPlanckConstant
+    private let fft: FFTPlan
+    // Makhoul twiddles e^{-iπk/2M}
+    private let twiddle: ComplexArray
+
+    /// - Parameters:
+    ///   - center: Mirror point c
+    ///   - halfWidth: Distance L from the mirror point to the outer boundary
+    ///   - count: Reduced grid size M (a power of two)
+    ///   - parity: Symmetry sector to simulate
+    ///   - mass: Particle mass in kg
+    ///   - potential: Potential energy in Joules sampled on
+    ///     `QuantumGrid.mirrorReduced(center:halfWidth:count:)`; V(c + x) = V(c - x) must hold
+    init(
+        center: Double, halfWidth: Double, count: Int, parity: Parity, mass: Double,
+        potential: [Double]
+    ) {
+        precondition(potential.count == count, "Potential does not match the reduced grid")
+        self.grid = QuantumGrid.mirrorReduced(center: center, halfWidth: halfWidth, count: count)
+        self.center = center
+        self.parity = parity
+        self.mass = mass
+        self.potential = potential
+        self.fft = FFTPlan(count: count)
+        self.twiddle = FFTPlan.phaseTable(
+            angles: (0..<count).map { -Double.pi * Double($0) / Double(2 * count) })
+    }
+
+    /// Wave number of the symmetry-adapted mode n: k_n = πn / L
+    private func modeWaveNumber(_ n: Int) -> Double {
+        return Double.pi * Double(n) / (grid.dx * Double(grid.count))
+    }
+
+    // MARK: - Conversion
+
+    /// Restrict a full-domain state to the irreducible half
+    func makeState(from psi: ComplexArray, on labGrid: QuantumGrid) -> ComplexArray {
+        var reduced = ComplexArray(count: grid.count)
+        for j in 0..<grid.count {
+            reduced[j] = psi.sample(at: grid.position(at: j), on: labGrid)
+        }
+        return reduced
+    }
+
+    /// Rebuild the full field on a display grid by mirroring the reduced state with the parity sign
+    func reconstructWaveFunction(_ reduced: ComplexArray, on labGrid: QuantumGrid) -> ComplexArray {
+        var psi = ComplexArray(count: labGrid.count)
+        // Extend by one mirrored sample so points between c and c + dx/2 interpolate correctly
+        var extended = ComplexArray(count: grid.count + 1)
+        extended[0] = parity.sign * reduced[0]
+        for j in 0..<grid.count {
+            extended[j + 1] = reduced[j]
+        }
+        let extendedGrid = QuantumGrid(
+            xMin: grid.xMin - grid.dx, xMax: grid.xMax, count: grid.count + 1)
+
+        for i in 0..<labGrid.count {
+            let offset = labGrid.position(at: i) - center
+            let value = extended.sample(at: center + abs(offset), on: extendedGrid)
+            psi[i] = offset < 0 ? parity.sign * value : value
+        }
+        return psi
+    }
+
+    // MARK: - Propagation
+
+    func propagate(_ psi: inout ComplexArray, timeStep dt: Double, steps: Int) {
+        guard steps > 0 else { return }
+        precondition(psi.count == grid.count, "State does not match propagator grid")
+
+        let m = grid.count
+        let length = vDSP_Length(m)
+
+        // Kinetic phase indexed by transform bin: the even sector maps bin k to mode k,
+        // the odd sector (DST via alternated DCT) maps bin k to mode M - k.
+        let kinetic = FFTPlan.phaseTable(
+            angles: (0..<m).map { k in
+                let wave = modeWaveNumber(parity == .even ? k : m - k)
+                return -hBar * wave * wave * dt / (2 * mass)
+            })
+        var halfPotential = FFTPlan.phaseTable(angles: potential.map { -$0 * dt / (2 * hBar) })
+        var fullPotential = FFTPlan.phaseTable(angles: potential.map { -$0 * dt / hBar })
+
+        var work = ComplexArray(count: m)
+        var spectrum = ComplexArray(count: m)
+
+        halfPotential.withSplitComplex { vHalf in
+            fullPotential.withSplitComplex { vFull in
+                psi.withSplitComplex { vDSP_zvmulD($0, 1, vHalf, 1, $0, 1, length, 1) }
+
+                for step in 0..<steps {
+                    applyKinetic(&psi, phase: kinetic, work: &work, spectrum: &spectrum)
+
+                    let potentialStep = step == steps - 1 ? vHalf : vFull
+                    psi.withSplitComplex { vDSP_zvmulD($0, 1, potentialStep, 1, $0, 1, length, 1) }
+                }
+            }
+        }
+    }
+
+    // MARK: - Private Methods
+
+    /// ψ ← T⁻¹ · diag(phase) · T · ψ with T the DCT-II (even) or DST-II (odd)
+    private func applyKinetic(
+        _ psi: inout ComplexArray, phase: ComplexArray, work: inout ComplexArray,
+        spectrum: inout ComplexArray
+    ) {
+        let m = grid.count
+        let alternate = parity == .odd
+
+        // Makhoul reordering: v_j = x_{2j}, v_{M-1-j} = x_{2j+1}; DST-II uses (-1)^j x_j
+        for j in 0..<(m / 2) {
+            let evenIndex = 2 * j
+            let oddIndex = 2 * j + 1
+            let oddSign = alternate ? -1.0 : 1.0
+            work.real[j] = psi.real[evenIndex]
+            work.imaginary[j] = psi.imaginary[evenIndex]
+            work.real[m - 1 - j] = oddSign * psi.real[oddIndex]
+            work.imaginary[m - 1 - j] = oddSign * psi.imaginary[oddIndex]
+        }
+
+        work.withSplitComplex { fft.forward($0) }
+
+        // X_k = ½(w_k V_k + w̄_k V_{M-k}) is the DCT-II of the (complex) input,
+        // then each coefficient picks up its kinetic phase
+        for k in 0..<m {
+            let mirror = (m - k) % m
+            let w = twiddle[k]
+            let v = work[k]
+            let vMirror = work[mirror]
+            let coefficient = 0.5 * (w * v + w.conjugate * vMirror)
+            spectrum[k] = coefficient * phase[k]
+        }
+
+        // Inverse: V_k = w̄_k (X_k - i X_{M-k}) with X_M = 0, then v = IFFT(V) / M
+        let inverseScale = 1.0 / Double(m)
+        for k in 0..<m {
+            let x = spectrum[k]
+            let xMirror = k == 0 ? Complex() : spectrum[m - k]
+            let minusIXMirror = Complex(real: xMirror.imaginary, imaginary: -xMirror.real)
+            work[k] = inverseScale * (twiddle[k].conjugate * (x + minusIXMirror))
+        }
+
+        work.withSplitComplex { fft.inverse($0) }
+
+        for j in 0..<(m / 2) {
+            let oddSign = alternate ? -1.0 : 1.0
+            psi.real[2 * j] = work.real[j]
+            psi.imaginary[2 * j] = work.imaginary[j]
+            psi.real[2 * j + 1] = oddSign * work.real[m - 1 - j]
+            psi.imaginary[2 * j + 1] = oddSign * work.imaginary[m - 1 - j]
+        }
+    }
+}
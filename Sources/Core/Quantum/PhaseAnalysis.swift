@@ -0,0 +1,118 @@
+import Accelerate
+import Foundation
+
+/// Phase of a sampled wave function and its spatial derivative
+struct PhaseField {
+    /// atan2(Im ψ, Re ψ) in (−π, π]
+    let wrapped: [Double]
+    /// Continuous phase, equal to `wrapped` at the first sample
+    let unwrapped: [Double]
+    /// Local wave number ∂φ/∂x in rad/m
+    let localWaveNumber: [Double]
+}
+
+extension ComplexArray {
+    /// Wrapped phase, unwrapped phase and local wave number in one chunk-parallel pass.
+    ///
+    /// The wrapped phase comes from a vectorized atan2 over each chunk. Unwrapping is a prefix
+    /// sum of neighbour differences reduced to [−π, π]: every chunk scans its own differences
+    /// in parallel, a short serial scan over the chunk totals gives each chunk's carry, and a
+    /// second parallel pass adds it. The local wave number is Im(ψ* ∂ψ)/|ψ|² with central
+    /// differences (one-sided at the ends), which stays smooth where atan2 jumps; |ψ|² is
+    /// clamped below at `densityFloor` times its maximum so nodes give k → 0 instead of noise.
+    /// - Parameters:
+    ///   - dx: Sample spacing in meters
+    ///   - chunkSize: Samples per parallel chunk
+    ///   - densityFloor: Relative density below which the wave number is regularized
+    func phaseField(dx: Double, chunkSize: Int = 4096, densityFloor: Double = 1e-10) -> PhaseField {
+        let n = count
+        guard n > 0 else {
+            return PhaseField(wrapped: [], unwrapped: [], localWaveNumber: [])
+        }
+
+        var wrapped = [Double](repeating: 0, count: n)
+        var unwrapped = [Double](repeating: 0, count: n)
+        var waveNumber = [Double](repeating: 0, count: n)
+
+        let chunk = max(1, chunkSize)
+        let chunks = (n + chunk - 1) / chunk
+        var carries = [Double](repeating: 0, count: chunks)
+
+        var peak = 0.0
+        vDSP_maxvD(probabilityDensity, 1, &peak, vDSP_Length(n))
+        let densityCutoff = max(peak * densityFloor, Double.leastNormalMagnitude)
+
+        real.withUnsafeBufferPointer { realBuffer in
+            imaginary.withUnsafeBufferPointer { imagBuffer in
+                wrapped.withUnsafeMutableBufferPointer { wrappedBuffer in
+                    unwrapped.withUnsafeMutableBufferPointer { unwrappedBuffer in
+                        waveNumber.withUnsafeMutableBufferPointer { waveNumberBuffer in
+                            carries.withUnsafeMutableBufferPointer { carryBuffer in
+                                let re = realBuffer.baseAddress!
+                                let im = imagBuffer.baseAddress!
+                                let phase = wrappedBuffer.baseAddress!
+                                let total = unwrappedBuffer.baseAddress!
+                                let k = waveNumberBuffer.baseAddress!
+                                let carry = carryBuffer.baseAddress!
+
+                                // Pass 1: atan2, chunk-local scan of wrapped differences, wave number
+                                WorkerPool.shared.concurrentPerform(iterations: chunks) { c in
+                                    let start = c * chunk
+                                    let end = min(start + chunk, n)
+                                    var length = Int32(end - start)
+                                    vvatan2(phase + start, im + start, re + start, &length)
+
+                                    var sum = 0.0
+                                    for i in start..<end {
+                                        if i > start {
+                                            sum += wrappedStep(phase[i] - phase[i - 1])
+                                        }
+                                        total[i] = sum
+
+                                        let left = max(i - 1, 0)
+                                        let right = min(i + 1, n - 1)
+                                        let span = Double(right - left) * dx
+                                        let density = re[i] * re[i] + im[i] * im[i]
+                                        k[i] = span > 0
+                                            ? (re[i] * (im[right] - im[left]) - im[i] * (re[right] - re[left]))
+                                                / (span * max(density, densityCutoff))
+                                            : 0
+                                    }
+                                    carry[c] = sum
+                                }
+
+                                // Scan of chunk totals plus the steps across chunk boundaries,
+                                // offset by the first sample's phase
+                                var running = phase[0]
+                                for c in 0..<chunks {
+                                    if c > 0 {
+                                        running += wrappedStep(phase[c * chunk] - phase[c * chunk - 1])
+                                    }
+                                    let chunkTotal = carry[c]
+                                    carry[c] = running
+                                    running += chunkTotal
+                                }
+
+                                // Pass 2: carry fix-up
+                                WorkerPool.shared.concurrentPerform(iterations: chunks) { c in
+                                    let start = c * chunk
+                                    var offset = carry[c]
+                                    vDSP_vsaddD(
+                                        total + start, 1, &offset, total + start, 1, vDSP_Length(min(chunk, n - start)))
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        return PhaseField(wrapped: wrapped, unwrapped: unwrapped, localWaveNumber: waveNumber)
+    }
+}
+
+/// Phase difference reduced to [−π, π]
+@inline(__always)
+private func wrappedStep(_ step: Double) -> Double {
+    return step - 2 * Double.pi * (step / (2 * Double.pi)).rounded()
+}
@@ -0,0 +1,126 @@
+import Foundation
+
+extension ComplexArray {
+    /// |ψ|² and the probability current j = (ħ/m) Im(ψ* ∂ψ/∂x) in one pass, with periodic
+    /// central differences (the same stencil as the current field of `compute_probability_density_current`).
+    /// The field is for display; detector fluxes use the spectral derivative of `FluxDetectors`.
+    func densityAndCurrent(dx: Double, mass: Double) -> (density: [Double], current: [Double]) {
+        let n = count
+        var density = [Double](repeating: 0, count: n)
+        var current = [Double](repeating: 0, count: n)
+        guard n > 1 else {
+            return (probabilityDensity, current)
+        }
+
+        let scale = QuantumMath.reducedPlanckConstant / (2 * mass * dx)
+        real.withUnsafeBufferPointer { realBuffer in
+            imaginary.withUnsafeBufferPointer { imagBuffer in
+                density.withUnsafeMutableBufferPointer { densityBuffer in
+                    current.withUnsafeMutableBufferPointer { currentBuffer in
+                        let re = realBuffer.baseAddress!
+                        let im = imagBuffer.baseAddress!
+                        let rho = densityBuffer.baseAddress!
+                        let j = currentBuffer.baseAddress!
+
+                        func point(_ i: Int, left: Int, right: Int) {
+                            rho[i] = re[i] * re[i] + im[i] * im[i]
+                            j[i] = scale * (re[i] * (im[right] - im[left]) - im[i] * (re[right] - re[left]))
+                        }
+
+                        point(0, left: n - 1, right: 1)
+                        for i in 1..<(n - 1) {
+                            point(i, left: i - 1, right: i + 1)
+                        }
+                        point(n - 1, left: n - 2, right: 0)
+                    }
+                }
+            }
+        }
+
+        return (density, current)
+    }
+}
+
+/// Time-integrated probability flux Φ_k = ∫ j(x_k, t) dt at fixed detector positions.
+///
+/// The current at each detector uses the periodic spectral derivative ψ'(x_i) = Σ_m w_m ψ_{i−m},
+/// w_m = (π/L)(−1)^m cot(πm/N) (1/sin for odd N), which is exact for every resolved wave number.
+/// Central differences read (ħ/m) sin(k dx)/dx instead of ħk/m, 6% low at k dx = 0.6, which is
+/// where the simulator's 10 eV packets sit on the default grid. The sum is bilinear in ψ, so the
+/// interference of incident and reflected parts still averages out of Φ. It is a pass of its own,
+/// O(N) per detector per step with the weights precomputed, on top of the density pass that the
+/// other observables share; the GPU kernel evaluates its detector cells with the same weights.
+/// For a normalized packet launched toward
+/// a scatterer, transmission is Φ at a detector beyond it and reflection is 1 − Φ at a detector
+/// between the launch point and the scatterer, once both parts have cleared their detectors
+/// and before anything wraps around the periodic grid onto them.
+struct FluxDetectors {
+    /// Requested detector positions in meters
+    let positions: [Double]
+    /// Grid cells nearest to `positions`
+    let indices: [Int]
+    let grid: QuantumGrid
+    let mass: Double
+    /// Spectral derivative weights w_m for offsets m = 0..<N (w_0 = 0)
+    private let derivativeWeights: [Double]
+
+    /// ∫ j dt per detector
+    private(set) var integratedFlux: [Double]
+    /// Total accumulated time
+    private(set) var elapsedTime = 0.0
+
+    init(positions: [Double], grid: QuantumGrid, mass: Double) {
+        self.positions = positions
+        self.grid = grid
+        self.mass = mass
+        self.indices = positions.map { position in
+            let index = Int(((position - grid.position(at: 0)) / grid.dx).rounded())
+            return min(max(index, 0), grid.count - 1)
+        }
+        self.integratedFlux = [Double](repeating: 0, count: positions.count)
+
+        self.derivativeWeights = FluxDetectors.derivativeWeights(count: grid.count, period: grid.xMax - grid.xMin)
+    }
+
+    /// Spectral derivative weights w_m for offsets m = 0..<N (w_0 = 0) of a grid with period `length`
+    static func derivativeWeights(count n: Int, period length: Double) -> [Double] {
+        let scale = Double.pi / length
+        return (0..<n).map { m in
+            guard m > 0 else { return 0 }
+            let angle = Double.pi * Double(m) / Double(n)
+            let sign: Double = m % 2 == 0 ? 1 : -1
+            return scale * sign * (n % 2 == 0 ? cos(angle) / sin(angle) : 1 / sin(angle))
+        }
+    }
+
+    /// Add j·dt at every detector for a state representing an interval of length `dt`
+    mutating func accumulate(_ psi: ComplexArray, timeStep dt: Double) {
+        for (k, current) in currents(psi).enumerated() {
+            integratedFlux[k] += current * dt
+        }
+        elapsedTime += dt
+    }
+
+    /// Probability current j at every detector
+    func currents(_ psi: ComplexArray) -> [Double] {
+        precondition(psi.count == grid.count, "State does not match detector grid")
+        let n = grid.count
+        let scale = QuantumMath.reducedPlanckConstant / mass
+
+        return indices.map { i in
+            var slopeReal = 0.0
+            var slopeImaginary = 0.0
+            for m in 1..<max(n, 1) {
+                let j = i >= m ? i - m : i - m + n
+                slopeReal += derivativeWeights[m] * psi.real[j]
+                slopeImaginary += derivativeWeights[m] * psi.imaginary[j]
+            }
+            return scale * (psi.real[i] * slopeImaginary - psi.imaginary[i] * slopeReal)
+        }
+    }
+
+    mutating func reset() {
+        integratedFlux = [Double](repeating: 0, count: positions.count)
+        elapsedTime = 0
+    }
+}
@@ -0,0 +1,270 @@
+import Accelerate
+import Foundation
+
+/// Counter-based Philox4x32-10 generator. The output is a pure function of (seed, stream,
+/// counter), so every trajectory owns an independent stream and an ensemble gives identical
+/// results however its trajectories are scheduled across threads.
+struct PhiloxGenerator: RandomNumberGenerator {
+    private let key: (UInt32, UInt32)
+    private let stream: UInt64
+    private var counter: UInt64 = 0
+    private var spare: UInt64?
+
+    init(seed: UInt64, stream: UInt64) {
+        self.key = (UInt32(truncatingIfNeeded: seed), UInt32(truncatingIfNeeded: seed >> 32))
+        self.stream = stream
+    }
+
+    mutating func next() -> UInt64 {
+        if let value = spare {
+            spare = nil
+            return value
+        }
+
+        let block = PhiloxGenerator.block(
+            counter: (
+                UInt32(truncatingIfNeeded: counter), UInt32(truncatingIfNeeded: counter >> 32),
+                UInt32(truncatingIfNeeded: stream), UInt32(truncatingIfNeeded: stream >> 32)
+            ),
+            key: key)
+        counter &+= 1
+
+        spare = UInt64(block.2) << 32 | UInt64(block.3)
+        return UInt64(block.0) << 32 | UInt64(block.1)
+    }
+
+    /// Uniform double in the open interval (0, 1)
+    mutating func nextUniform() -> Double {
+        return (Double(next() >> 11) + 0.5) * 0x1p-53
+    }
+
+    /// Ten Philox rounds on one 128-bit counter
+    static func block(counter: (UInt32, UInt32, UInt32, UInt32), key: (UInt32, UInt32))
+        -> (UInt32, UInt32, UInt32, UInt32)
+    {
+        var c = counter
+        var k = key
+        for _ in 0..<10 {
+            let product0 = UInt32(0xD251_1F53).multipliedFullWidth(by: c.0)
+            let product1 = UInt32(0xCD9E_8D57).multipliedFullWidth(by: c.2)
+            c = (product1.high ^ c.1 ^ k.0, product1.low, product0.high ^ c.3 ^ k.1, product0.low)
+            k = (k.0 &+ 0x9E37_79B9, k.1 &+ 0xBB67_AE85)
+        }
+        return c
+    }
+}
+
+/// Running mean and variance of vector samples (Welford), mergeable across workers
+struct StreamingStatistics {
+    private(set) var count = 0
+    private(set) var mean: [Double]
+    // Sum of squared deviations from the mean
+    private var deviations: [Double]
+
+    init(dimension: Int) {
+        self.mean = [Double](repeating: 0, count: dimension)
+        self.deviations = [Double](repeating: 0, count: dimension)
+    }
+
+    mutating func add(_ sample: [Double]) {
+        precondition(sample.count == mean.count, "Sample does not match statistics dimension")
+        count += 1
+        let weight = 1 / Double(count)
+        for i in 0..<mean.count {
+            let delta = sample[i] - mean[i]
+            mean[i] += delta * weight
+            deviations[i] += delta * (sample[i] - mean[i])
+        }
+    }
+
+    /// Combine with statistics gathered on another worker (Chan et al.)
+    mutating func merge(_ other: StreamingStatistics) {
+        guard other.count > 0 else { return }
+        guard count > 0 else {
+            self = other
+            return
+        }
+
+        let total = count + other.count
+        let fraction = Double(other.count) / Double(total)
+        let cross = Double(count) * fraction
+        for i in 0..<mean.count {
+            let delta = other.mean[i] - mean[i]
+            mean[i] += delta * fraction
+            deviations[i] += other.deviations[i] + delta * delta * cross
+        }
+        count = total
+    }
+
+    /// Unbiased sample variance
+    var variance: [Double] {
+        guard count > 1 else { return [Double](repeating: 0, count: mean.count) }
+        return deviations.map { $0 / Double(count - 1) }
+    }
+
+    /// Standard error of the mean
+    var standardError: [Double] {
+        guard count > 0 else { return variance }
+        return variance.map { sqrt($0 / Double(count)) }
+    }
+}
+
+/// Monte Carlo wave-function (quantum jump) unraveling of the Lindblad equation.
+///
+/// Each trajectory evolves a pure state under the no-jump evolution
+/// e^{−Γdt/4} U(dt) e^{−Γdt/4} (Γ = Σ L_j†L_j), letting its norm decay. When ‖ψ‖² falls below a
+/// uniform random threshold, a jump L_j ψ is applied with probability ∝ ‖L_j ψ‖², the state is
+/// renormalized and a new threshold is drawn. Averaging observables over trajectories reproduces
+/// the density-matrix result of `LindbladPropagator` with memory O(grid) per worker.
+///
+/// Trajectories are independent, so workers take them in a fixed stride and accumulate
+/// observables in private `StreamingStatistics` merged at the end; the run scales with the core
+/// count and, with per-trajectory Philox streams, is reproducible for a given seed.
+final class QuantumJumpEnsemble {
+    struct Configuration {
+        /// Number of trajectories
+        var trajectoryCount = 1000
+        /// Seed shared by all trajectory streams
+        var seed: UInt64 = 0x5EED
+        /// Steps between recorded samples
+        var sampleInterval = 1
+        /// Parallel workers
+        var workerCount = ProcessInfo.processInfo.activeProcessorCount
+    }
+
+    struct Result {
+        /// Times of the recorded samples, starting at 0
+        let sampleTimes: [Double]
+        /// Observable statistics at each sample time
+        let statistics: [StreamingStatistics]
+        /// Jumps per trajectory
+        let jumps: StreamingStatistics
+    }
+
+    /// Coherent part of the evolution
+    let unitary: QuantumPropagator
+    let channels: [LindbladPropagator.Channel]
+    var configuration: Configuration
+
+    private let fft: FFTPlan
+
+    var grid: QuantumGrid {
+        return unitary.grid
+    }
+
+    init(
+        unitary: QuantumPropagator, channels: [LindbladPropagator.Channel],
+        configuration: Configuration = Configuration()
+    ) {
+        self.unitary = unitary
+        self.channels = channels
+        self.configuration = configuration
+        self.fft = FFTPlan(count: unitary.grid.count)
+    }
+
+    /// Run the ensemble from a normalized initial state
+    /// - Parameters:
+    ///   - initialState: Normalized state shared by every trajectory
+    ///   - dt: Time step
+    ///   - steps: Steps per trajectory
+    ///   - observable: Observable of a normalized state (called concurrently); defaults to |ψ|²
+    func run(
+        _ initialState: ComplexArray, timeStep dt: Double, steps: Int,
+        observable: ((ComplexArray) -> [Double])? = nil
+    ) -> Result {
+        precondition(initialState.count == grid.count, "State does not match propagator grid")
+
+        let measure = observable ?? { $0.probabilityDensity }
+        let interval = max(1, configuration.sampleInterval)
+        let sampleSteps = Array(stride(from: 0, through: steps, by: interval))
+        let dimension = measure(initialState).count
+        let workers = max(1, min(configuration.workerCount, configuration.trajectoryCount))
+
+        // Private accumulators per worker, merged after the parallel loop
+        var workerStatistics = (0..<workers).map { _ in
+            (0..<sampleSteps.count).map { _ in StreamingStatistics(dimension: dimension) }
+        }
+        var workerJumps = (0..<workers).map { _ in StreamingStatistics(dimension: 1) }
+
+        workerStatistics.withUnsafeMutableBufferPointer { statisticsBuffer in
+            workerJumps.withUnsafeMutableBufferPointer { jumpsBuffer in
+                let statistics = statisticsBuffer.baseAddress!
+                let jumps = jumpsBuffer.baseAddress!
+
+                WorkerPool.shared.concurrentPerform(iterations: workers) { worker in
+                    for trajectory in stride(from: worker, to: configuration.trajectoryCount, by: workers) {
+                        var generator = PhiloxGenerator(seed: configuration.seed, stream: UInt64(trajectory))
+                        let jumpCount = runTrajectory(
+                            initialState, timeStep: dt, steps: steps, interval: interval, generator: &generator
+                        ) { sample, state in
+                            statistics[worker][sample].add(measure(state))
+                        }
+                        jumps[worker].add([Double(jumpCount)])
+                    }
+                }
+            }
+        }
+
+        var statistics = workerStatistics[0]
+        var jumps = workerJumps[0]
+        for worker in 1..<workers {
+            for sample in 0..<sampleSteps.count {
+                statistics[sample].merge(workerStatistics[worker][sample])
+            }
+            jumps.merge(workerJumps[worker])
+        }
+
+        return Result(sampleTimes: sampleSteps.map { Double($0) * dt }, statistics: statistics, jumps: jumps)
+    }
+
+    // MARK: - Private Methods
+
+    /// One trajectory; `record` receives each sample index with the normalized state
+    /// - Returns: Number of jumps
+    private func runTrajectory(
+        _ initialState: ComplexArray, timeStep dt: Double, steps: Int, interval: Int,
+        generator: inout PhiloxGenerator, record: (Int, ComplexArray) -> Void
+    ) -> Int {
+        let dx = grid.dx
+        var psi = initialState
+        var threshold = generator.nextUniform()
+        var jumpCount = 0
+
+        record(0, psi)
+        guard steps > 0 else { return 0 }
+
+        for step in 1...steps {
+            channels.noJump(&psi, duration: dt / 2, on: grid, using: fft)
+            unitary.propagate(&psi, timeStep: dt, steps: 1)
+            channels.noJump(&psi, duration: dt / 2, on: grid, using: fft)
+
+            // The squared norm is the no-jump probability since the last jump
+            if !channels.isEmpty && psi.squaredMagnitudeSum * dx <= threshold {
+                let candidates = channels.map { $0.jump(psi, on: grid, using: fft) }
+                let rates = candidates.map { $0.squaredMagnitudeSum }
+                var choice = generator.nextUniform() * rates.reduce(0, +)
+                var selected = candidates.count - 1
+                for (index, rate) in rates.enumerated() {
+                    choice -= rate
+                    if choice <= 0 {
+                        selected = index
+                        break
+                    }
+                }
+
+                psi = candidates[selected]
+                psi.normalize(dx: dx)
+                threshold = generator.nextUniform()
+                jumpCount += 1
+            }
+
+            if step % interval == 0 {
+                var normalized = psi
+                normalized.normalize(dx: dx)
+                record(step / interval, normalized)
+            }
+        }
+
+        return jumpCount
+    }
+}
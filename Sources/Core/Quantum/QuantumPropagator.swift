@@ -0,0 +1,393 @@
+import Accelerate
+import Foundation
+
+// MARK: - Wave Function Storage
+
+/// Split-complex (structure-of-arrays) storage for a sampled wave function.
+/// Real and imaginary parts live in separate contiguous arrays so they can be handed
+/// directly to vDSP as a `DSPDoubleSplitComplex`.
+struct ComplexArray {
+    var real: [Double]
+    var imaginary: [Double]
+
+    /// Number of complex samples
+    var count: Int {
+        return real.count
+    }
+
+    /// Create a zero-filled array
+    init(count: Int) {
+        self.real = [Double](repeating: 0.0, count: count)
+        self.imaginary = [Double](repeating: 0.0, count: count)
+    }
+
+    /// Wrap existing component arrays (must have equal length)
+    init(real: [Double], imaginary: [Double]) {
+        precondition(real.count == imaginary.count, "Component arrays must have equal length")
+        self.real = real
+        self.imaginary = imaginary
+    }
+
+    /// Access a single sample as a `Complex`
+    subscript(index: Int) -> Complex {
+        get {
+            return Complex(real: real[index], imaginary: imaginary[index])
+        }
+        set {
+            real[index] = newValue.real
+            imaginary[index] = newValue.imaginary
+        }
+    }
+
+    /// Probability density |ψ|² at every sample
+    var probabilityDensity: [Double] {
+        var result = [Double](repeating: 0.0, count: count)
+        vDSP_vsqD(real, 1, &result, 1, vDSP_Length(count))
+        vDSP_vmaD(imaginary, 1, imaginary, 1, result, 1, &result, 1, vDSP_Length(count))
+        return result
+    }
+
+    /// Sum of |ψ|² over all samples (multiply by dx for the integrated norm)
+    var squaredMagnitudeSum: Double {
+        var realSum = 0.0
+        var imagSum = 0.0
+        vDSP_svesqD(real, 1, &realSum, vDSP_Length(count))
+        vDSP_svesqD(imaginary, 1, &imagSum, vDSP_Length(count))
+        return realSum + imagSum
+    }
+
+    /// Integrated norm ∫|ψ|² dx on a uniform grid
+    func norm(dx: Double) -> Double {
+        return squaredMagnitudeSum * dx
+    }
+
+    /// Multiply every sample by a real factor
+    mutating func scale(by factor: Double) {
+        var s = factor
+        vDSP_vsmulD(real, 1, &s, &real, 1, vDSP_Length(count))
+        vDSP_vsmulD(imaginary, 1, &s, &imaginary, 1, vDSP_Length(count))
+    }
+
+    /// Rescale so that ∫|ψ|² dx = 1
+    mutating func normalize(dx: Double) {
+        let n = norm(dx: dx)
+        if n > 0 {
+            scale(by: 1.0 / sqrt(n))
+        }
+    }
+
+    /// Element-wise a + b
+    static func + (lhs: ComplexArray, rhs: ComplexArray) -> ComplexArray {
+        var result = ComplexArray(count: lhs.count)
+        vDSP_vaddD(lhs.real, 1, rhs.real, 1, &result.real, 1, vDSP_Length(lhs.count))
+        vDSP_vaddD(lhs.imaginary, 1, rhs.imaginary, 1, &result.imaginary, 1, vDSP_Length(lhs.count))
+        return result
+    }
+
+    /// Element-wise a - b
+    static func - (lhs: ComplexArray, rhs: ComplexArray) -> ComplexArray {
+        var result = ComplexArray(count: lhs.count)
+        // vDSP_vsubD computes B - A
+        vDSP_vsubD(rhs.real, 1, lhs.real, 1, &result.real, 1, vDSP_Length(lhs.count))
+        vDSP_vsubD(rhs.imaginary, 1, lhs.imaginary, 1, &result.imaginary, 1, vDSP_Length(lhs.count))
+        return result
+    }
+
+    /// Euclidean distance ‖a - b‖ between two states of equal length
+    static func distance(_ a: ComplexArray, _ b: ComplexArray) -> Double {
+        return sqrt((a - b).squaredMagnitudeSum)
+    }
+
+    /// Linear interpolation of the samples at lab position `x`; zero outside the grid
+    func sample(at x: Double, on grid: QuantumGrid) -> Complex {
+        let position = (x - grid.xMin) / grid.dx
+        let lower = Int(position.rounded(.down))
+        guard lower >= 0 && lower < grid.count else { return Complex() }
+
+        let upper = min(lower + 1, grid.count - 1)
+        let fraction = position - Double(lower)
+        return (1 - fraction) * self[lower] + fraction * self[upper]
+    }
+}
+
+// MARK: - Spatial Grid
+
+/// Uniform 1D grid used by the time propagators.
+/// The grid has `count` cells of width `dx` starting at `xMin`; the point at `xMax`
+/// is the periodic image of the first point and is not stored.
+struct QuantumGrid {
+    let xMin: Double
+    let xMax: Double
+    let count: Int
+
+    /// Grid spacing in meters
+    var dx: Double {
+        return (xMax - xMin) / Double(count)
+    }
+
+    /// Position of sample `index` in meters
+    func position(at index: Int) -> Double {
+        return xMin + Double(index) * dx
+    }
+
+    /// All sample positions
+    var positions: [Double] {
+        return (0..<count).map { position(at: $0) }
+    }
+
+    /// Angular wave numbers in FFT ordering (0, 1, …, N/2-1, -N/2, …, -1) · 2π/L
+    var waveNumbers: [Double] {
+        let dk = 2.0 * Double.pi / (xMax - xMin)
+        return (0..<count).map { j in
+            Double(j < count / 2 ? j : j - count) * dk
+        }
+    }
+}
+
+// MARK: - Propagator Interface
+
+/// Common interface for numerical time propagators of the 1D Schrödinger equation.
+/// Implementations must be safe to call concurrently from multiple threads on
+/// independent states (scratch storage is allocated per call, not per instance).
+protocol QuantumPropagator {
+    /// Grid the propagator operates on
+    var grid: QuantumGrid { get }
+
+    /// Advance `psi` by `steps` steps of size `dt` seconds
+    func propagate(_ psi: inout ComplexArray, timeStep dt: Double, steps: Int)
+}
+
+extension QuantumPropagator {
+    /// Advance `psi` across `duration` seconds using `steps` equal steps
+    func propagate(_ psi: inout ComplexArray, duration: Double, steps: Int) {
+        guard steps > 0 else { return }
+        propagate(&psi, timeStep: duration / Double(steps), steps: steps)
+    }
+}
+
+// MARK: - FFT Plan
+
+/// Reusable radix-2 complex FFT plan for split-complex data.
+/// vDSP FFT setups are read-only after creation, so one plan can serve many threads.
+final class FFTPlan {
+    let count: Int
+
+    private let log2n: vDSP_Length
+    private let setup: FFTSetupD
+
+    /// - Parameter count: Transform length; must be a power of two
+    init(count: Int) {
+        precondition(count > 1 && count & (count - 1) == 0, "FFT length must be a power of two")
+        self.count = count
+        self.log2n = vDSP_Length(count.trailingZeroBitCount)
+
+        guard let setup = vDSP_create_fftsetupD(log2n, FFTRadix(kFFTRadix2)) else {
+            fatalError("Failed to create FFT setup of length \(count)")
+        }
+        self.setup = setup
+    }
+
+    deinit {
+        vDSP_destroy_fftsetupD(setup)
+    }
+
+    /// In-place forward transform of `count` samples spaced `stride` elements apart
+    func forward(_ data: UnsafePointer<DSPDoubleSplitComplex>, stride: Int = 1) {
+        vDSP_fft_zipD(setup, data, vDSP_Stride(stride), log2n, FFTDirection(kFFTDirection_Forward))
+    }
+
+    /// In-place inverse transform (unscaled; the caller applies 1/N)
+    func inverse(_ data: UnsafePointer<DSPDoubleSplitComplex>, stride: Int = 1) {
+        vDSP_fft_zipD(setup, data, vDSP_Stride(stride), log2n, FFTDirection(kFFTDirection_Inverse))
+    }
+
+    /// In-place 2D forward transform of a row-major `rows × columns` array whose samples are
+    /// `stride` elements apart. Both dimensions must be powers of two no larger than `count`.
+    func forward2D(_ data: UnsafePointer<DSPDoubleSplitComplex>, columns: Int, rows: Int, stride: Int = 1) {
+        transform2D(data, columns: columns, rows: rows, stride: stride, direction: kFFTDirection_Forward)
+    }
+
+    /// In-place 2D inverse transform (unscaled; the caller applies 1/(rows·columns))
+    func inverse2D(_ data: UnsafePointer<DSPDoubleSplitComplex>, columns: Int, rows: Int, stride: Int = 1) {
+        transform2D(data, columns: columns, rows: rows, stride: stride, direction: kFFTDirection_Inverse)
+    }
+
+    private func transform2D(
+        _ data: UnsafePointer<DSPDoubleSplitComplex>, columns: Int, rows: Int, stride: Int, direction: Int
+    ) {
+        precondition(columns <= count && rows <= count, "2D transform exceeds the plan length")
+        vDSP_fft2d_zipD(
+            setup, data, vDSP_Stride(stride), vDSP_Stride(stride * columns),
+            vDSP_Length(columns.trailingZeroBitCount), vDSP_Length(rows.trailingZeroBitCount),
+            FFTDirection(direction))
+    }
+
+    /// Build e^{iθ}·scale for every angle
+    static func phaseTable(angles: [Double], scale: Double = 1) -> ComplexArray {
+        var table = ComplexArray(count: angles.count)
+        var n = Int32(angles.count)
+        vvsincos(&table.imaginary, &table.real, angles, &n)
+        if scale != 1 {
+            table.scale(by: scale)
+        }
+        return table
+    }
+}
+
+// MARK: - Absorbing Edges
+
+/// Smooth absorbing layers at both ends of a periodic grid.
+/// Damping the layers after every step removes density that reaches an edge instead of letting
+/// it wrap around to the other side, and `apply` returns the norm it removed so engines can
+/// report it. The mask is real and diagonal, so it commutes with the potential phase and may be
+/// applied between the fused half-steps. The cos^{1/8} profile switches on slowly enough that
+/// outgoing waves are absorbed with little reflection.
+struct AbsorbingEdges {
+    /// Grid indices inside either layer
+    let cells: [Int]
+    /// Mask factor at each of `cells` (0 at the grid edge, 1 at the inner end of the layer)
+    let factors: [Double]
+
+    /// - Parameters:
+    ///   - count: Grid size
+    ///   - layerCells: Cells in each absorbing layer (clamped to half the grid)
+    init(count: Int, layerCells: Int) {
+        let layer = max(1, min(layerCells, count / 2))
+        var cells = [Int]()
+        var factors = [Double]()
+        for i in 0..<count {
+            let depth = min(i, count - 1 - i)
+            guard depth < layer else { continue }
+            cells.append(i)
+            factors.append(pow(max(0, cos(Double.pi / 2 * Double(layer - depth) / Double(layer))), 0.125))
+        }
+        self.cells = cells
+        self.factors = factors
+    }
+
+    /// Damp both layers of `psi` in place and return the integrated norm removed
+    func apply(to psi: UnsafePointer<DSPDoubleSplitComplex>, dx: Double) -> Double {
+        let re = psi.pointee.realp
+        let im = psi.pointee.imagp
+        var removed = 0.0
+
+        for (i, factor) in zip(cells, factors) {
+            removed += (re[i] * re[i] + im[i] * im[i]) * (1 - factor * factor)
+            re[i] *= factor
+            im[i] *= factor
+        }
+        return removed * dx
+    }
+}
+
+// MARK: - Split-Operator Propagator
+
+/// Second-order Strang split-operator propagator using vDSP radix-2 FFTs.
+/// Each step applies e^{-iVdt/2ħ} · F⁻¹ e^{-iħk²dt/2m} F · e^{-iVdt/2ħ};
+/// consecutive potential half-steps are fused into one full step.
+final class SplitOperatorPropagator: QuantumPropagator {
+    let grid: QuantumGrid
+    let mass: Double
+    let potential: [Double]
+
+    private let hBar = QuantumMath.reducedPlanckConstant
+    private let fft: FFTPlan
+
+    /// - Parameters:
+    ///   - grid: Periodic grid; `grid.count` must be a power of two
+    ///   - mass: Particle mass in kg
+    ///   - potential: Potential energy in Joules at each grid point
+    ///   - fft: Optional shared plan of length `grid.count` (created if nil)
+    init(grid: QuantumGrid, mass: Double, potential: [Double], fft: FFTPlan? = nil) {
+        precondition(potential.count == grid.count, "Potential must match grid size")
+        precondition(fft == nil || fft?.count == grid.count, "FFT plan does not match grid size")
+
+        self.grid = grid
+        self.mass = mass
+        self.potential = potential
+        self.fft = fft ?? FFTPlan(count: grid.count)
+    }
+
+    func propagate(_ psi: inout ComplexArray, timeStep dt: Double, steps: Int) {
+        evolve(&psi, timeStep: dt, steps: steps, edges: nil, cancellation: nil)
+    }
+
+    /// Advance `psi` until `steps` steps are done or `cancellation` is set; a cancelled run
+    /// closes its last step, so `psi` is a complete state at an earlier time
+    func propagate(_ psi: inout ComplexArray, timeStep dt: Double, steps: Int, cancellation: CancellationToken?) {
+        evolve(&psi, timeStep: dt, steps: steps, edges: nil, cancellation: cancellation)
+    }
+
+    /// Advance `psi` with absorbing layers at both grid ends instead of periodic wrap-around
+    /// - Returns: Integrated norm absorbed by the layers
+    @discardableResult
+    func propagate(
+        _ psi: inout ComplexArray, timeStep dt: Double, steps: Int, absorbing edges: AbsorbingEdges,
+        cancellation: CancellationToken? = nil
+    ) -> Double {
+        return evolve(&psi, timeStep: dt, steps: steps, edges: edges, cancellation: cancellation)
+    }
+
+    /// Strang steps V/2 · T · V/2 with the inner half steps merged; checks `cancellation` once per step
+    @discardableResult
+    private func evolve(
+        _ psi: inout ComplexArray, timeStep dt: Double, steps: Int, edges: AbsorbingEdges?,
+        cancellation: CancellationToken?
+    ) -> Double {
+        guard steps > 0 else { return 0 }
+        precondition(psi.count == grid.count, "State does not match propagator grid")
+
+        let length = vDSP_Length(grid.count)
+        var absorbed = 0.0
+
+        // Phase tables for this time step; the inverse-FFT 1/N scaling is folded
+        // into the kinetic factor so no separate scaling pass is needed.
+        var halfPotential = FFTPlan.phaseTable(angles: potential.map { -$0 * dt / (2 * hBar) })
+        var fullPotential = FFTPlan.phaseTable(angles: potential.map { -$0 * dt / hBar })
+        var kinetic = FFTPlan.phaseTable(
+            angles: grid.waveNumbers.map { -hBar * $0 * $0 * dt / (2 * mass) },
+            scale: 1.0 / Double(grid.count))
+
+        psi.withSplitComplex { state in
+            halfPotential.withSplitComplex { vHalf in
+                fullPotential.withSplitComplex { vFull in
+                    kinetic.withSplitComplex { k in
+                        vDSP_zvmulD(state, 1, vHalf, 1, state, 1, length, 1)
+
+                        for step in 0..<steps {
+                            let isLast = step == steps - 1 || cancellation?.isCancelled == true
+                            fft.forward(state)
+                            vDSP_zvmulD(state, 1, k, 1, state, 1, length, 1)
+                            fft.inverse(state)
+
+                            let potentialStep = isLast ? vHalf : vFull
+                            vDSP_zvmulD(state, 1, potentialStep, 1, state, 1, length, 1)
+
+                            if let edges = edges {
+                                absorbed += edges.apply(to: state, dx: grid.dx)
+                            }
+                            if isLast {
+                                break
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return absorbed
+    }
+}
+
+extension ComplexArray {
+    /// Expose both component arrays as a `DSPDoubleSplitComplex` for vDSP calls
+    mutating func withSplitComplex<Result>(
+        _ body: (UnsafePointer<DSPDoubleSplitComplex>) throws -> Result
+    ) rethrows -> Result {
+        return try real.withUnsafeMutableBufferPointer { re in
+            try imaginary.withUnsafeMutableBufferPointer { im in
+                var split = DSPDoubleSplitComplex(realp: re.baseAddress!, imagp: im.baseAddress!)
+                return try body(&split)
+            }
+        }
+    }
+}
@@ -0,0 +1,304 @@
+import Foundation
+
+/// Discrete level structure with relative transition dipoles
+struct NLevelSystem {
+    /// Level energies in Joules
+    let energies: [Double]
+    /// Relative transition dipoles d_ij (symmetric, row-major N×N)
+    let dipoles: [Double]
+
+    var levelCount: Int {
+        return energies.count
+    }
+
+    init(energies: [Double], dipoles: [Double]) {
+        precondition(dipoles.count == energies.count * energies.count, "Dipoles must be an N×N matrix")
+        self.energies = energies
+        self.dipoles = dipoles
+    }
+
+    /// Levels with equal unit dipoles between every pair
+    init(energies: [Double]) {
+        let n = energies.count
+        self.init(energies: energies, dipoles: (0..<(n * n)).map { $0 / n == $0 % n ? 0 : 1 })
+    }
+
+    func dipole(_ i: Int, _ j: Int) -> Double {
+        return dipoles[i * levelCount + j]
+    }
+}
+
+/// Target-level population over a grid of drive detunings and Rabi frequencies
+struct RabiMap {
+    /// Drive detunings Δ = ω − ω₀ in rad/s
+    let detunings: [Double]
+    /// Rabi frequencies Ω of the driven transition in rad/s (Ω ∝ √intensity)
+    let rabiFrequencies: [Double]
+    /// Times of the recorded samples in seconds
+    let sampleTimes: [Double]
+    /// populations[(sample · rabiFrequencies.count + r) · detunings.count + d]
+    let populations: [Double]
+
+    func population(detuning d: Int, rabiFrequency r: Int, sample s: Int) -> Double {
+        return populations[(s * rabiFrequencies.count + r) * detunings.count + d]
+    }
+}
+
+/// Batched amplitude solver for an N-level system driven near one of its transitions.
+///
+/// In the rotating-wave frame each level i carries n_i photons of the drive, with
+/// n_i = round((E_i − E_from)/ħω₀) so that the driven transition has n = 0 → 1. The frame
+/// Hamiltonian is then time independent for every (Δ, Ω): the diagonal holds the residual
+/// detunings (E_i − E_from)/ħ − n_i(ω₀ + Δ) and levels with |n_i − n_j| = 1 are coupled by
+/// Ω d_ij/(2 d_ref). Levels detuned by more than `detuningCutoff` times the drive scale are
+/// eliminated, since they only shift the others slightly but would force tiny steps.
+///
+/// Every (Δ, Ω) pair is one lane: lanes share a SIMD vector as wide as the host runs natively
+/// (two, four or eight doubles, chosen at run time from `CPUFeatures`) and a fixed-step RK4
+/// update, and lane groups are spread over cores, so maps of 10⁴–10⁶ points are one pass of
+/// straight-line vector code with no per-lane branching.
+final class RabiMapSolver {
+    let system: NLevelSystem
+    let initialLevel: Int
+    let targetLevel: Int
+
+    /// Levels detuned by more than this multiple of max(|Δ|) + max(Ω) are dropped
+    var detuningCutoff = 100.0
+    /// SIMD lane groups per parallel task
+    var groupsPerTask = 64
+
+    private let hBar = QuantumMath.reducedPlanckConstant
+    // ω₀ of the driven transition (negative for emission)
+    private let resonance: Double
+    // Photon number of each level in the rotating frame
+    private let photons: [Int]
+
+    /// - Parameters:
+    ///   - system: Level structure
+    ///   - initialLevel: Index of the initially populated level
+    ///   - targetLevel: Index of the level whose population is mapped (driven on resonance at Δ = 0)
+    init(system: NLevelSystem, initialLevel: Int, targetLevel: Int) {
+        precondition(initialLevel != targetLevel, "The driven transition needs two distinct levels")
+        precondition(system.dipole(initialLevel, targetLevel) != 0, "The driven transition must have a dipole")
+        self.system = system
+        self.initialLevel = initialLevel
+        self.targetLevel = targetLevel
+
+        let hBar = QuantumMath.reducedPlanckConstant
+        let resonance = (system.energies[targetLevel] - system.energies[initialLevel]) / hBar
+        precondition(resonance != 0, "The driven levels must differ in energy")
+        self.resonance = resonance
+        self.photons = system.energies.map {
+            Int((($0 - system.energies[initialLevel]) / (hBar * resonance)).rounded())
+        }
+    }
+
+    /// Rabi period 2π/Ω of the bare resonant two-level transition
+    static func rabiPeriod(rabiFrequency: Double) -> Double {
+        return 2 * Double.pi / rabiFrequency
+    }
+
+    /// Integrate every (Δ, Ω) pair from the initial level for `duration`
+    /// - Parameters:
+    ///   - detunings: Drive detunings in rad/s
+    ///   - rabiFrequencies: Rabi frequencies of the driven transition in rad/s
+    ///   - duration: Drive duration in seconds
+    ///   - steps: Minimum number of RK4 steps (raised automatically for accuracy)
+    ///   - sampleCount: Number of evenly spaced samples recorded, the last at `duration`
+    ///   - cancellation: Checked before each lane group; lanes not yet solved stay at zero
+    func solve(
+        detunings: [Double], rabiFrequencies: [Double], duration: Double, steps: Int = 200, sampleCount: Int = 1,
+        cancellation: CancellationToken? = nil
+    ) -> RabiMap {
+        let laneCount = detunings.count * rabiFrequencies.count
+        let samples = max(1, sampleCount)
+        let direction: Double = resonance >= 0 ? 1 : -1
+
+        // Keep the driven pair and any level close enough to resonance to matter
+        let maxDetuning = detunings.reduce(0) { max($0, abs($1)) }
+        let maxRabi = rabiFrequencies.reduce(0) { max($0, abs($1)) }
+        let residual = (0..<system.levelCount).map {
+            (system.energies[$0] - system.energies[initialLevel]) / hBar - Double(photons[$0]) * resonance
+        }
+        let active = (0..<system.levelCount).filter {
+            $0 == initialLevel || $0 == targetLevel
+                || abs(residual[$0]) <= detuningCutoff * (maxDetuning + maxRabi)
+        }
+        let m = active.count
+        let initialIndex = active.firstIndex(of: initialLevel)!
+        let targetIndex = active.firstIndex(of: targetLevel)!
+
+        // Rotating-frame couplings in units of Ω/2
+        let reference = system.dipole(initialLevel, targetLevel)
+        var couplings = [(i: Int, j: Int, strength: Double)]()
+        for i in 0..<m {
+            for j in (i + 1)..<m where abs(photons[active[i]] - photons[active[j]]) == 1 {
+                let dipole = system.dipole(active[i], active[j])
+                if dipole != 0 {
+                    couplings.append((i, j, dipole / reference))
+                }
+            }
+        }
+
+        // RK4 needs dt·max|H| well inside its stability region for phase accuracy
+        let maxPhotons = active.reduce(0) { max($0, abs(photons[$1])) }
+        let maxCoupling = (0..<m).map { i in
+            couplings.reduce(0) { $0 + ($1.i == i || $1.j == i ? abs($1.strength) : 0) }
+        }.max() ?? 0
+        let maxRate = active.reduce(0) { max($0, abs(residual[$1])) } + Double(maxPhotons) * maxDetuning
+            + 0.5 * maxRabi * maxCoupling
+        let stepsPerSample = max(
+            (steps + samples - 1) / samples, Int((duration * maxRate / (0.5 * Double(samples))).rounded(.up)), 1)
+        let dt = duration / Double(stepsPerSample * samples)
+
+        let problem = LaneProblem(
+            detunings: detunings, rabiFrequencies: rabiFrequencies, direction: direction,
+            base: active.map { residual[$0] }, photonNumbers: active.map { Double(photons[$0]) },
+            couplings: couplings, initialIndex: initialIndex, targetIndex: targetIndex, samples: samples,
+            stepsPerSample: stepsPerSample, dt: dt)
+        var populations = [Double](repeating: 0, count: laneCount * samples)
+
+        populations.withUnsafeMutableBufferPointer { buffer in
+            let output = buffer.baseAddress!
+
+            // Widest vectors the host runs natively (see `CPUFeatures`)
+            switch CPUFeatures.current.vectorLevel.doubleLanes {
+            case 8...:
+                integrate(problem, lanes: SIMD8<Double>.self, into: output, cancellation: cancellation)
+            case 4..<8:
+                integrate(problem, lanes: SIMD4<Double>.self, into: output, cancellation: cancellation)
+            default:
+                integrate(problem, lanes: SIMD2<Double>.self, into: output, cancellation: cancellation)
+            }
+        }
+
+        return RabiMap(
+            detunings: detunings, rabiFrequencies: rabiFrequencies,
+            sampleTimes: (1...samples).map { duration * Double($0) / Double(samples) },
+            populations: populations)
+    }
+
+    // MARK: - Private Methods
+
+    /// Everything the lane kernel needs, fixed for one `solve`
+    private struct LaneProblem {
+        let detunings: [Double]
+        let rabiFrequencies: [Double]
+        let direction: Double
+        // Residual detunings and photon numbers of the active levels
+        let base: [Double]
+        let photonNumbers: [Double]
+        let couplings: [(i: Int, j: Int, strength: Double)]
+        let initialIndex: Int
+        let targetIndex: Int
+        let samples: Int
+        let stepsPerSample: Int
+        let dt: Double
+    }
+
+    /// RK4 over every (Δ, Ω) pair, `Lanes.scalarCount` pairs per vector
+    private func integrate<Lanes: SIMD>(
+        _ problem: LaneProblem, lanes: Lanes.Type, into output: UnsafeMutablePointer<Double>,
+        cancellation: CancellationToken?
+    ) where Lanes.Scalar == Double {
+        let (detunings, rabiFrequencies, direction) = (problem.detunings, problem.rabiFrequencies, problem.direction)
+        let (base, photonNumbers, couplings) = (problem.base, problem.photonNumbers, problem.couplings)
+        let (initialIndex, targetIndex) = (problem.initialIndex, problem.targetIndex)
+        let (samples, stepsPerSample, dt) = (problem.samples, problem.stepsPerSample, problem.dt)
+        let m = base.count
+        let laneCount = detunings.count * rabiFrequencies.count
+        let groups = (laneCount + Lanes.scalarCount - 1) / Lanes.scalarCount
+        let tasks = (groups + groupsPerTask - 1) / groupsPerTask
+
+        WorkerPool.shared.concurrentPerform(iterations: tasks) { task in
+            // State, RK stage input, stage derivative and accumulator (re and im each), diagonal
+            var workspace = [Lanes](repeating: .zero, count: 9 * m)
+            workspace.withUnsafeMutableBufferPointer { scratch in
+                let re = scratch.baseAddress!
+                let im = re + m
+                let stageRe = im + m
+                let stageIm = stageRe + m
+                let slopeRe = stageIm + m
+                let slopeIm = slopeRe + m
+                let sumRe = slopeIm + m
+                let sumIm = sumRe + m
+                let diagonal = sumIm + m
+
+                for group in (task * groupsPerTask)..<min((task + 1) * groupsPerTask, groups) {
+                    if cancellation?.isCancelled == true {
+                        break
+                    }
+                    var detuning = Lanes.zero
+                    var halfRabi = Lanes.zero
+                    for lane in 0..<Lanes.scalarCount {
+                        let index = min(group * Lanes.scalarCount + lane, laneCount - 1)
+                        detuning[lane] = direction * detunings[index % detunings.count]
+                        halfRabi[lane] = 0.5 * rabiFrequencies[index / detunings.count]
+                    }
+
+                    for i in 0..<m {
+                        diagonal[i] = Lanes(repeating: base[i]) - photonNumbers[i] * detuning
+                        re[i] = .zero
+                        im[i] = .zero
+                    }
+                    re[initialIndex] = Lanes(repeating: 1)
+
+                    // (slope) = −iH(stage)
+                    func derivative() {
+                        for i in 0..<m {
+                            slopeRe[i] = diagonal[i] * stageIm[i]
+                            slopeIm[i] = -diagonal[i] * stageRe[i]
+                        }
+                        for coupling in couplings {
+                            let w = coupling.strength * halfRabi
+                            slopeRe[coupling.i] += w * stageIm[coupling.j]
+                            slopeIm[coupling.i] -= w * stageRe[coupling.j]
+                            slopeRe[coupling.j] += w * stageIm[coupling.i]
+                            slopeIm[coupling.j] -= w * stageRe[coupling.i]
+                        }
+                    }
+
+                    for sample in 0..<samples {
+                        for _ in 0..<stepsPerSample {
+                            for i in 0..<m {
+                                stageRe[i] = re[i]
+                                stageIm[i] = im[i]
+                            }
+                            derivative()
+                            for i in 0..<m {
+                                sumRe[i] = slopeRe[i]
+                                sumIm[i] = slopeIm[i]
+                                stageRe[i] = re[i] + (0.5 * dt) * slopeRe[i]
+                                stageIm[i] = im[i] + (0.5 * dt) * slopeIm[i]
+                            }
+                            derivative()
+                            for i in 0..<m {
+                                sumRe[i] += 2 * slopeRe[i]
+                                sumIm[i] += 2 * slopeIm[i]
+                                stageRe[i] = re[i] + (0.5 * dt) * slopeRe[i]
+                                stageIm[i] = im[i] + (0.5 * dt) * slopeIm[i]
+                            }
+                            derivative()
+                            for i in 0..<m {
+                                sumRe[i] += 2 * slopeRe[i]
+                                sumIm[i] += 2 * slopeIm[i]
+                                stageRe[i] = re[i] + dt * slopeRe[i]
+                                stageIm[i] = im[i] + dt * slopeIm[i]
+                            }
+                            derivative()
+                            for i in 0..<m {
+                                re[i] += (dt / 6) * (sumRe[i] + slopeRe[i])
+                                im[i] += (dt / 6) * (sumIm[i] + slopeIm[i])
+                            }
+                        }
+
+                        let population = re[targetIndex] * re[targetIndex] + im[targetIndex] * im[targetIndex]
+                        for lane in 0..<Lanes.scalarCount where group * Lanes.scalarCount + lane < laneCount {
+                            output[sample * laneCount + group * Lanes.scalarCount + lane] = population[lane]
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
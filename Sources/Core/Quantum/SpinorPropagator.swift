@@ -0,0 +1,336 @@
+import Accelerate
+import Foundation
+import simd
+
+// MARK: - Spinor Storage
+
+/// Two-component spinor ψ = (ψ↑, ψ↓) sampled on a grid.
+/// Real and imaginary planes are kept separate as in `ComplexArray`, but within each plane the
+/// two components are interleaved per point (real[2j] = Re ψ↑_j, real[2j + 1] = Re ψ↓_j), so a
+/// point's spin pair loads as one SIMD2 for 2×2 spin operations while each component is still
+/// an ordinary stride-2 vector for vDSP FFTs.
+struct SpinorArray {
+    var real: [Double]
+    var imaginary: [Double]
+
+    /// Number of grid points
+    var count: Int {
+        return real.count / 2
+    }
+
+    /// Create a zero spinor field
+    init(count: Int) {
+        self.real = [Double](repeating: 0, count: 2 * count)
+        self.imaginary = [Double](repeating: 0, count: 2 * count)
+    }
+
+    /// Interleave two component fields of equal length
+    init(up: ComplexArray, down: ComplexArray) {
+        precondition(up.count == down.count, "Spinor components must have equal length")
+        self.init(count: up.count)
+        for j in 0..<up.count {
+            real[2 * j] = up.real[j]
+            real[2 * j + 1] = down.real[j]
+            imaginary[2 * j] = up.imaginary[j]
+            imaginary[2 * j + 1] = down.imaginary[j]
+        }
+    }
+
+    /// One component (0 = ↑, 1 = ↓) as a contiguous array
+    func component(_ index: Int) -> ComplexArray {
+        var result = ComplexArray(count: count)
+        // Strided copy: one column out of a count × 2 matrix
+        real.withUnsafeBufferPointer {
+            vDSP_mmovD($0.baseAddress! + index, &result.real, 1, vDSP_Length(count), 2, 1)
+        }
+        imaginary.withUnsafeBufferPointer {
+            vDSP_mmovD($0.baseAddress! + index, &result.imaginary, 1, vDSP_Length(count), 2, 1)
+        }
+        return result
+    }
+
+    /// Total density |ψ↑|² + |ψ↓|² at every point
+    var probabilityDensity: [Double] {
+        var squares = [Double](repeating: 0, count: real.count)
+        vDSP_vsqD(real, 1, &squares, 1, vDSP_Length(real.count))
+        vDSP_vmaD(imaginary, 1, imaginary, 1, squares, 1, &squares, 1, vDSP_Length(real.count))
+
+        // Add the interleaved pairs
+        var result = [Double](repeating: 0, count: count)
+        squares.withUnsafeBufferPointer {
+            vDSP_vaddD($0.baseAddress!, 2, $0.baseAddress! + 1, 2, &result, 1, vDSP_Length(count))
+        }
+        return result
+    }
+
+    /// Sum of |ψ↑|² + |ψ↓|² over all points
+    var squaredMagnitudeSum: Double {
+        var realSum = 0.0
+        var imagSum = 0.0
+        vDSP_svesqD(real, 1, &realSum, vDSP_Length(real.count))
+        vDSP_svesqD(imaginary, 1, &imagSum, vDSP_Length(imaginary.count))
+        return realSum + imagSum
+    }
+
+    /// Rescale so that Σ(|ψ↑|² + |ψ↓|²)·dV = 1
+    mutating func normalize(cellVolume: Double) {
+        let norm = squaredMagnitudeSum * cellVolume
+        guard norm > 0 else { return }
+        var factor = 1 / sqrt(norm)
+        vDSP_vsmulD(real, 1, &factor, &real, 1, vDSP_Length(real.count))
+        vDSP_vsmulD(imaginary, 1, &factor, &imaginary, 1, vDSP_Length(imaginary.count))
+    }
+
+    /// In-place FFT of both components (unscaled inverse). `shape` selects a 2D transform of a
+    /// row-major `rows × columns` grid; nil transforms the whole array as one 1D line.
+    mutating func fourierTransform(using fft: FFTPlan, shape: (columns: Int, rows: Int)? = nil, inverse: Bool) {
+        for component in 0..<2 {
+            withComponent(component) { data in
+                switch (shape, inverse) {
+                case (nil, false):
+                    fft.forward(data, stride: 2)
+                case (nil, true):
+                    fft.inverse(data, stride: 2)
+                case (let shape?, false):
+                    fft.forward2D(data, columns: shape.columns, rows: shape.rows, stride: 2)
+                case (let shape?, true):
+                    fft.inverse2D(data, columns: shape.columns, rows: shape.rows, stride: 2)
+                }
+            }
+        }
+    }
+
+    /// Expose one component (0 = ↑, 1 = ↓) as a split-complex view with element stride 2
+    mutating func withComponent<Result>(
+        _ index: Int, _ body: (UnsafePointer<DSPDoubleSplitComplex>) throws -> Result
+    ) rethrows -> Result {
+        return try real.withUnsafeMutableBufferPointer { re in
+            try imaginary.withUnsafeMutableBufferPointer { im in
+                var split = DSPDoubleSplitComplex(realp: re.baseAddress! + index, imagp: im.baseAddress! + index)
+                return try body(&split)
+            }
+        }
+    }
+}
+
+// MARK: - Spin Matrices
+
+/// One 2×2 complex matrix per grid point, stored column-wise as SIMD2 (↑ row, ↓ row) pairs.
+struct SpinMatrixTable {
+    private var column0Real: [SIMD2<Double>]
+    private var column0Imag: [SIMD2<Double>]
+    private var column1Real: [SIMD2<Double>]
+    private var column1Imag: [SIMD2<Double>]
+
+    var count: Int {
+        return column0Real.count
+    }
+
+    /// U_j = scale · e^{-iτ(h0_j + h_j·σ)/ħ} at every point
+    /// - Parameters:
+    ///   - scalar: Spin-independent energy h0 in Joules
+    ///   - field: Spin field h in Joules (H = h0 + h·σ)
+    ///   - duration: Time τ
+    ///   - scale: Real factor folded into the table (e.g. the inverse FFT 1/N)
+    init(scalar: [Double], field: [SIMD3<Double>], duration: Double, scale: Double = 1) {
+        precondition(scalar.count == field.count, "Scalar and spin parts must have equal length")
+        let hBar = QuantumMath.reducedPlanckConstant
+        let n = scalar.count
+
+        column0Real = [SIMD2<Double>](repeating: .zero, count: n)
+        column0Imag = [SIMD2<Double>](repeating: .zero, count: n)
+        column1Real = [SIMD2<Double>](repeating: .zero, count: n)
+        column1Imag = [SIMD2<Double>](repeating: .zero, count: n)
+
+        for j in 0..<n {
+            // e^{-iθ n·σ} = cos θ − i sin θ (n·σ), times the scalar phase e^{-i h0 τ/ħ}
+            let magnitude = simd_length(field[j])
+            let theta = magnitude * duration / hBar
+            let axis = magnitude > 0 ? field[j] / magnitude : SIMD3<Double>(0, 0, 0)
+            let c = cos(theta)
+            let s = sin(theta)
+
+            let m00 = Complex(real: c, imaginary: -s * axis.z)
+            let m01 = Complex(real: -s * axis.y, imaginary: -s * axis.x)
+            let m10 = Complex(real: s * axis.y, imaginary: -s * axis.x)
+            let m11 = Complex(real: c, imaginary: s * axis.z)
+
+            let phase = scale * Complex.fromPolar(r: 1, theta: -scalar[j] * duration / hBar)
+            let a = phase * m00
+            let b = phase * m01
+            let d = phase * m10
+            let e = phase * m11
+
+            column0Real[j] = SIMD2(a.real, d.real)
+            column0Imag[j] = SIMD2(a.imaginary, d.imaginary)
+            column1Real[j] = SIMD2(b.real, e.real)
+            column1Imag[j] = SIMD2(b.imaginary, e.imaginary)
+        }
+    }
+
+    /// ψ_j ← U_j ψ_j for every point
+    func apply(to psi: inout SpinorArray) {
+        precondition(psi.count == count, "Spinor does not match matrix table")
+        let n = count
+
+        psi.real.withUnsafeMutableBufferPointer { realBuffer in
+            psi.imaginary.withUnsafeMutableBufferPointer { imagBuffer in
+                // Each (↑, ↓) pair is one SIMD2 lane pair
+                realBuffer.baseAddress!.withMemoryRebound(to: SIMD2<Double>.self, capacity: n) { re in
+                    imagBuffer.baseAddress!.withMemoryRebound(to: SIMD2<Double>.self, capacity: n) { im in
+                        for j in 0..<n {
+                            let r = re[j]
+                            let i = im[j]
+                            let c0r = column0Real[j]
+                            let c0i = column0Imag[j]
+                            let c1r = column1Real[j]
+                            let c1i = column1Imag[j]
+
+                            // ψ' = col0·ψ↑ + col1·ψ↓
+                            re[j] = c0r * r.x - c0i * i.x + c1r * r.y - c1i * i.y
+                            im[j] = c0r * i.x + c0i * r.x + c1r * i.y + c1i * r.y
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// MARK: - Spinor Propagator
+
+/// Split-operator propagator for a spin-½ particle on a periodic 1D or 2D grid with
+/// H = p²/2m + V(r) + b(r)·σ + h_SO(k)·σ.
+///
+/// The Zeeman field b enters with the potential in position space and the spin–orbit field
+/// h_SO(k) = α(k_y, −k_x, 0) + β(k_x, −k_y, 0) (Rashba α, Dresselhaus β) enters with the kinetic
+/// energy in momentum space. Each half of the Strang step is then one fused 2×2 matrix per
+/// point applied to the interleaved spinor, so the cost per component matches the scalar
+/// split-operator path: one FFT pair and one pass over the data per stage.
+final class SpinorPropagator {
+    /// Linear spin–orbit coupling strengths in J·m
+    struct SpinOrbitCoupling {
+        var rashba: Double = 0
+        var dresselhaus: Double = 0
+    }
+
+    /// One (1D) or two (2D) axes, x first; fields are stored x-fastest
+    let axes: [QuantumGrid]
+    let mass: Double
+    /// Spin-independent potential in Joules
+    let potential: [Double]
+    /// Zeeman field b in Joules (H_Z = b·σ)
+    let zeemanField: [SIMD3<Double>]
+    let spinOrbit: SpinOrbitCoupling
+
+    private let hBar = QuantumMath.reducedPlanckConstant
+    private let fft: FFTPlan
+
+    /// Number of grid points
+    var count: Int {
+        return axes.reduce(1) { $0 * $1.count }
+    }
+
+    /// Volume element Π dx_a
+    var cellVolume: Double {
+        return axes.reduce(1) { $0 * $1.dx }
+    }
+
+    /// - Parameters:
+    ///   - axes: One or two periodic axis grids (power-of-two sizes)
+    ///   - mass: Particle mass in kg
+    ///   - potential: Spin-independent potential in Joules at every point
+    ///   - zeemanField: Zeeman field b in Joules at every point
+    ///   - spinOrbit: Rashba and Dresselhaus couplings
+    init(
+        axes: [QuantumGrid], mass: Double, potential: [Double], zeemanField: [SIMD3<Double>],
+        spinOrbit: SpinOrbitCoupling = SpinOrbitCoupling()
+    ) {
+        precondition(axes.count == 1 || axes.count == 2, "Spinor propagator supports 1D and 2D grids")
+        let total = axes.reduce(1) { $0 * $1.count }
+        precondition(potential.count == total && zeemanField.count == total, "Fields must match the grid")
+
+        self.axes = axes
+        self.mass = mass
+        self.potential = potential
+        self.zeemanField = zeemanField
+        self.spinOrbit = spinOrbit
+        self.fft = FFTPlan(count: axes.map { $0.count }.max()!)
+    }
+
+    // MARK: - Observables
+
+    /// Spin-resolved densities |ψ↑|² and |ψ↓|²
+    func spinDensities(_ psi: SpinorArray) -> (up: [Double], down: [Double]) {
+        let n = psi.count
+        var up = [Double](repeating: 0, count: n)
+        var down = [Double](repeating: 0, count: n)
+        for j in 0..<n {
+            up[j] = psi.real[2 * j] * psi.real[2 * j] + psi.imaginary[2 * j] * psi.imaginary[2 * j]
+            down[j] =
+                psi.real[2 * j + 1] * psi.real[2 * j + 1] + psi.imaginary[2 * j + 1] * psi.imaginary[2 * j + 1]
+        }
+        return (up, down)
+    }
+
+    /// Spin polarization (⟨σx⟩, ⟨σy⟩, ⟨σz⟩) of a normalized spinor
+    func spinExpectation(_ psi: SpinorArray) -> SIMD3<Double> {
+        var sigma = SIMD3<Double>(0, 0, 0)
+        for j in 0..<psi.count {
+            let up = Complex(real: psi.real[2 * j], imaginary: psi.imaginary[2 * j])
+            let down = Complex(real: psi.real[2 * j + 1], imaginary: psi.imaginary[2 * j + 1])
+            // ψ↑*ψ↓ gives σx (real part) and σy (imaginary part)
+            let coherence = up.conjugate * down
+            sigma += SIMD3(2 * coherence.real, 2 * coherence.imaginary, up.absoluteSquared - down.absoluteSquared)
+        }
+        return sigma * cellVolume
+    }
+
+    // MARK: - Propagation
+
+    /// Advance ψ by `steps` Strang steps of size `dt`
+    func propagate(_ psi: inout SpinorArray, timeStep dt: Double, steps: Int) {
+        guard steps > 0 else { return }
+        precondition(psi.count == count, "Spinor does not match propagator grid")
+
+        let positionHalf = SpinMatrixTable(scalar: potential, field: zeemanField, duration: dt / 2)
+        let positionFull = SpinMatrixTable(scalar: potential, field: zeemanField, duration: dt)
+        let momentum = momentumTable(duration: dt)
+
+        let shape: (columns: Int, rows: Int)? = axes.count == 2 ? (axes[0].count, axes[1].count) : nil
+
+        positionHalf.apply(to: &psi)
+        for step in 0..<steps {
+            psi.fourierTransform(using: fft, shape: shape, inverse: false)
+            momentum.apply(to: &psi)
+            psi.fourierTransform(using: fft, shape: shape, inverse: true)
+
+            (step == steps - 1 ? positionHalf : positionFull).apply(to: &psi)
+        }
+    }
+
+    // MARK: - Private Methods
+
+    /// Kinetic plus spin–orbit propagator in FFT ordering, with the inverse FFT scale folded in
+    private func momentumTable(duration: Double) -> SpinMatrixTable {
+        let kx = axes[0].waveNumbers
+        let ky = axes.count == 2 ? axes[1].waveNumbers : [0]
+        let alpha = spinOrbit.rashba
+        let beta = spinOrbit.dresselhaus
+
+        var kinetic = [Double]()
+        var field = [SIMD3<Double>]()
+        kinetic.reserveCapacity(count)
+        field.reserveCapacity(count)
+
+        for y in ky {
+            for x in kx {
+                kinetic.append(hBar * hBar * (x * x + y * y) / (2 * mass))
+                field.append(SIMD3(alpha * y + beta * x, -alpha * x - beta * y, 0))
+            }
+        }
+
+        return SpinMatrixTable(
+            scalar: kinetic, field: field, duration: duration, scale: 1.0 / Double(count))
+    }
+}
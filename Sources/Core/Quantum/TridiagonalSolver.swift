@@ -0,0 +1,280 @@
+import Foundation
+
+/// Precomputed Thomas-algorithm factorization of a complex tridiagonal matrix.
+/// Factorizing once and solving many right-hand sides makes implicit schemes with a
+/// fixed time step cost O(n) per line with no divisions in the inner loops.
+struct TridiagonalFactorization {
+    let count: Int
+
+    // Sub-diagonal a_j (a_0 unused)
+    private let lowerReal: [Double]
+    private let lowerImag: [Double]
+    // Modified super-diagonal c'_j = c_j / denom_j
+    private let upperReal: [Double]
+    private let upperImag: [Double]
+    // 1 / denom_j with denom_j = b_j - a_j c'_{j-1}
+    private let pivotReal: [Double]
+    private let pivotImag: [Double]
+
+    /// - Parameters:
+    ///   - lower: Sub-diagonal (element 0 ignored)
+    ///   - diagonal: Main diagonal
+    ///   - upper: Super-diagonal (element n-1 ignored)
+    init(lower: ComplexArray, diagonal: ComplexArray, upper: ComplexArray) {
+        let n = diagonal.count
+        precondition(lower.count == n && upper.count == n, "Tridiagonal bands must have equal length")
+
+        var cr = [Double](repeating: 0, count: n)
+        var ci = [Double](repeating: 0, count: n)
+        var pr = [Double](repeating: 0, count: n)
+        var pi = [Double](repeating: 0, count: n)
+
+        for j in 0..<n {
+            var denom = diagonal[j]
+            if j > 0 {
+                denom = denom - lower[j] * Complex(real: cr[j - 1], imaginary: ci[j - 1])
+            }
+            let pivot = Complex(real: 1, imaginary: 0) / denom
+            pr[j] = pivot.real
+            pi[j] = pivot.imaginary
+
+            if j < n - 1 {
+                let modified = upper[j] * pivot
+                cr[j] = modified.real
+                ci[j] = modified.imaginary
+            }
+        }
+
+        self.count = n
+        self.lowerReal = lower.real
+        self.lowerImag = lower.imaginary
+        self.upperReal = cr
+        self.upperImag = ci
+        self.pivotReal = pr
+        self.pivotImag = pi
+    }
+
+    /// Solve A x = d in place for one (possibly strided) line of a larger array
+    func solve(real: UnsafeMutablePointer<Double>, imaginary: UnsafeMutablePointer<Double>, stride: Int = 1) {
+        // Forward sweep: d'_j = (d_j - a_j d'_{j-1}) / denom_j
+        var prevR = 0.0
+        var prevI = 0.0
+        for j in 0..<count {
+            let index = j * stride
+            var dr = real[index]
+            var di = imaginary[index]
+            if j > 0 {
+                dr -= lowerReal[j] * prevR - lowerImag[j] * prevI
+                di -= lowerReal[j] * prevI + lowerImag[j] * prevR
+            }
+            prevR = dr * pivotReal[j] - di * pivotImag[j]
+            prevI = dr * pivotImag[j] + di * pivotReal[j]
+            real[index] = prevR
+            imaginary[index] = prevI
+        }
+
+        // Back substitution: x_j = d'_j - c'_j x_{j+1}
+        var nextR = real[(count - 1) * stride]
+        var nextI = imaginary[(count - 1) * stride]
+        for j in Swift.stride(from: count - 2, through: 0, by: -1) {
+            let index = j * stride
+            let xr = real[index] - (upperReal[j] * nextR - upperImag[j] * nextI)
+            let xi = imaginary[index] - (upperReal[j] * nextI + upperImag[j] * nextR)
+            real[index] = xr
+            imaginary[index] = xi
+            nextR = xr
+            nextI = xi
+        }
+    }
+
+    /// Solve A x = d in place for `lanes` independent lines that share this matrix.
+    /// Lanes are contiguous and point j of every line starts at `j * lineStride`, so the
+    /// inner loop runs across lines with unit stride and vectorizes.
+    func solve(
+        real: UnsafeMutablePointer<Double>, imaginary: UnsafeMutablePointer<Double>, lanes: Int,
+        lineStride: Int
+    ) {
+        // Forward sweep, one row of lanes at a time
+        for j in 0..<count {
+            let re = real + j * lineStride
+            let im = imaginary + j * lineStride
+            let pr = pivotReal[j]
+            let pi = pivotImag[j]
+
+            if j > 0 {
+                let previousRe = re - lineStride
+                let previousIm = im - lineStride
+                let ar = lowerReal[j]
+                let ai = lowerImag[j]
+                for lane in 0..<lanes {
+                    let dr = re[lane] - (ar * previousRe[lane] - ai * previousIm[lane])
+                    let di = im[lane] - (ar * previousIm[lane] + ai * previousRe[lane])
+                    re[lane] = dr * pr - di * pi
+                    im[lane] = dr * pi + di * pr
+                }
+            } else {
+                for lane in 0..<lanes {
+                    let dr = re[lane]
+                    let di = im[lane]
+                    re[lane] = dr * pr - di * pi
+                    im[lane] = dr * pi + di * pr
+                }
+            }
+        }
+
+        // Back substitution
+        for j in Swift.stride(from: count - 2, through: 0, by: -1) {
+            let re = real + j * lineStride
+            let im = imaginary + j * lineStride
+            let nextRe = re + lineStride
+            let nextIm = im + lineStride
+            let cr = upperReal[j]
+            let ci = upperImag[j]
+            for lane in 0..<lanes {
+                let nr = nextRe[lane]
+                let ni = nextIm[lane]
+                re[lane] -= cr * nr - ci * ni
+                im[lane] -= cr * ni + ci * nr
+            }
+        }
+    }
+
+    /// Solve A x = d in place for a contiguous state
+    func solve(_ rhs: inout ComplexArray) {
+        precondition(rhs.count == count, "Right-hand side does not match matrix size")
+        rhs.real.withUnsafeMutableBufferPointer { re in
+            rhs.imaginary.withUnsafeMutableBufferPointer { im in
+                solve(real: re.baseAddress!, imaginary: im.baseAddress!)
+            }
+        }
+    }
+}
+
+/// Crank–Nicolson (Cayley) step u ← (W + iτK)⁻¹ (W - iτK) u for a real symmetric
+/// tridiagonal operator K and positive diagonal weights W, with τ = dt / 2ħ.
+/// The step is exactly unitary in the W-weighted norm Σ w_j |u_j|², so it stays stable
+/// on strongly non-uniform grids and next to the axis or origin.
+struct CrankNicolsonStep {
+    let count: Int
+
+    private let weights: [Double]
+    private let diagonal: [Double]
+    private let offDiagonal: [Double]
+    private let tau: Double
+    private let factorization: TridiagonalFactorization
+
+    /// - Parameters:
+    ///   - weights: Positive diagonal weights w_j (all ones for a uniform grid)
+    ///   - diagonal: K_jj
+    ///   - offDiagonal: K_{j,j+1} = K_{j+1,j} (length n - 1)
+    ///   - tau: dt / 2ħ
+    init(weights: [Double], diagonal: [Double], offDiagonal: [Double], tau: Double) {
+        let n = diagonal.count
+        precondition(weights.count == n && offDiagonal.count == n - 1, "Operator bands have inconsistent lengths")
+
+        var lower = ComplexArray(count: n)
+        var main = ComplexArray(count: n)
+        var upper = ComplexArray(count: n)
+        for j in 0..<n {
+            main[j] = Complex(real: weights[j], imaginary: tau * diagonal[j])
+            if j > 0 {
+                lower[j] = Complex(real: 0, imaginary: tau * offDiagonal[j - 1])
+            }
+            if j < n - 1 {
+                upper[j] = Complex(real: 0, imaginary: tau * offDiagonal[j])
+            }
+        }
+
+        self.count = n
+        self.weights = weights
+        self.diagonal = diagonal
+        self.offDiagonal = offDiagonal
+        self.tau = tau
+        self.factorization = TridiagonalFactorization(lower: lower, diagonal: main, upper: upper)
+    }
+
+    /// Apply the step in place to one (possibly strided) line
+    func apply(real: UnsafeMutablePointer<Double>, imaginary: UnsafeMutablePointer<Double>, stride: Int = 1) {
+        // Right-hand side (W - iτK)u, computed in place with a one-sample lag
+        var previousR = 0.0
+        var previousI = 0.0
+        for j in 0..<count {
+            let index = j * stride
+            let ur = real[index]
+            let ui = imaginary[index]
+
+            var kr = diagonal[j] * ur
+            var ki = diagonal[j] * ui
+            if j > 0 {
+                kr += offDiagonal[j - 1] * previousR
+                ki += offDiagonal[j - 1] * previousI
+            }
+            if j < count - 1 {
+                kr += offDiagonal[j] * real[index + stride]
+                ki += offDiagonal[j] * imaginary[index + stride]
+            }
+
+            // (W - iτK)u = W u + τ (K u_i) - iτ (K u_r)
+            real[index] = weights[j] * ur + tau * ki
+            imaginary[index] = weights[j] * ui - tau * kr
+
+            previousR = ur
+            previousI = ui
+        }
+
+        factorization.solve(real: real, imaginary: imaginary, stride: stride)
+    }
+
+    /// Apply the step in place to `lanes` independent lines laid out lane-contiguously
+    /// (point j of every line starts at `j * lineStride`); the inner loops vectorize across lines.
+    func apply(
+        real: UnsafeMutablePointer<Double>, imaginary: UnsafeMutablePointer<Double>, lanes: Int,
+        lineStride: Int
+    ) {
+        // Two saved rows: the original values of row j-1 (zero before the first row) and row j
+        var saved = [Double](repeating: 0, count: 4 * lanes)
+        saved.withUnsafeMutableBufferPointer { buffer in
+            var previousR = buffer.baseAddress!
+            var previousI = previousR + lanes
+            var currentR = previousI + lanes
+            var currentI = currentR + lanes
+
+            for j in 0..<count {
+                let re = real + j * lineStride
+                let im = imaginary + j * lineStride
+                currentR.update(from: re, count: lanes)
+                currentI.update(from: im, count: lanes)
+
+                // Missing neighbours contribute through zero coefficients
+                let w = weights[j]
+                let d = diagonal[j]
+                let lower = j > 0 ? offDiagonal[j - 1] : 0
+                let upper = j < count - 1 ? offDiagonal[j] : 0
+                let nextRe = j < count - 1 ? re + lineStride : re
+                let nextIm = j < count - 1 ? im + lineStride : im
+
+                for lane in 0..<lanes {
+                    let kr = d * currentR[lane] + lower * previousR[lane] + upper * nextRe[lane]
+                    let ki = d * currentI[lane] + lower * previousI[lane] + upper * nextIm[lane]
+                    re[lane] = w * currentR[lane] + tau * ki
+                    im[lane] = w * currentI[lane] - tau * kr
+                }
+
+                swap(&previousR, &currentR)
+                swap(&previousI, &currentI)
+            }
+        }
+
+        factorization.solve(real: real, imaginary: imaginary, lanes: lanes, lineStride: lineStride)
+    }
+
+    /// Apply the step in place to a contiguous state
+    func apply(_ psi: inout ComplexArray) {
+        precondition(psi.count == count, "State does not match operator size")
+        psi.real.withUnsafeMutableBufferPointer { re in
+            psi.imaginary.withUnsafeMutableBufferPointer { im in
+                apply(real: re.baseAddress!, imaginary: im.baseAddress!)
+            }
+        }
+    }
+}
@@ -0,0 +1,331 @@
+import Accelerate
+import Foundation
+
+/// Exchange symmetry of two identical particles
+enum ExchangeSymmetry {
+    case bosonic
+    case fermionic
+
+    /// Sign picked up by ψ under x₁ ↔ x₂
+    var sign: Double {
+        switch self {
+        case .bosonic: return 1
+        case .fermionic: return -1
+        }
+    }
+}
+
+/// Two-particle wave function ψ(x₁, x₂) stored on the triangle x₁ ≤ x₂ only.
+/// Row i holds the x₂ indices j = i…N−1 contiguously starting at `offset(row: i)`;
+/// the other half of the square follows from ψ(x₂, x₁) = ±ψ(x₁, x₂).
+struct TwoParticleState {
+    var real: [Double]
+    var imaginary: [Double]
+    /// Points per coordinate
+    let gridCount: Int
+    let symmetry: ExchangeSymmetry
+
+    init(gridCount: Int, symmetry: ExchangeSymmetry) {
+        let size = gridCount * (gridCount + 1) / 2
+        self.real = [Double](repeating: 0, count: size)
+        self.imaginary = [Double](repeating: 0, count: size)
+        self.gridCount = gridCount
+        self.symmetry = symmetry
+    }
+
+    /// Start of row i in the packed triangle
+    static func offset(row i: Int, gridCount n: Int) -> Int {
+        return i * n - i * (i - 1) / 2
+    }
+
+    /// ψ(x_i, x_j) for any i, j, reflecting across the diagonal as needed
+    subscript(i: Int, j: Int) -> Complex {
+        get {
+            let (row, column, sign) = i <= j ? (i, j, 1.0) : (j, i, symmetry.sign)
+            let index = TwoParticleState.offset(row: row, gridCount: gridCount) + column - row
+            return Complex(real: sign * real[index], imaginary: sign * imaginary[index])
+        }
+        set {
+            let (row, column, sign) = i <= j ? (i, j, 1.0) : (j, i, symmetry.sign)
+            let index = TwoParticleState.offset(row: row, gridCount: gridCount) + column - row
+            real[index] = sign * newValue.real
+            imaginary[index] = sign * newValue.imaginary
+        }
+    }
+}
+
+/// Two identical particles on a 1D box, i.e. one particle on the 2D grid (x₁, x₂).
+///
+/// Exchange symmetry is built into the storage: only the triangle x₁ ≤ x₂ is kept and
+/// stencil neighbours that fall across the diagonal are read back with the exchange sign,
+/// so memory and work are halved and (anti)symmetry cannot drift. Time stepping is the
+/// Visscher staggered leapfrog of `VisscherPropagator` with the five-point Laplacian and
+/// Dirichlet walls: ψ vanishes one cell beyond each end of `grid`, i.e. at xMin − dx and at
+/// xMax, so the grid is a box rather than periodic (see `QuantumSimulator.makeBoxGrid`).
+/// Each sweep walks row bands in parallel and column tiles within a band, so the three source
+/// rows of a tile stay in cache while every row of the band reuses them.
+/// The closing half step also accumulates the one-body density, so the reduced density at
+/// the output time costs no extra pass over the state.
+final class TwoParticlePropagator {
+    let grid: QuantumGrid
+    let mass: Double
+    let symmetry: ExchangeSymmetry
+    /// One-body potential energy in Joules
+    let potential: [Double]
+
+    /// Rows per parallel band and columns per cache tile
+    var tileSize = (rows: 32, columns: 256)
+
+    private let hBar = QuantumMath.reducedPlanckConstant
+    // V(x₁) + V(x₂) + W(|x₁ − x₂|) on the packed triangle
+    private let pairPotential: [Double]
+
+    /// Points per coordinate
+    var gridCount: Int {
+        return grid.count
+    }
+
+    /// Largest stable step: the five-point Laplacian doubles the 1D kinetic bound
+    var stableTimeStep: Double {
+        let maxPotential = pairPotential.reduce(0) { max($0, abs($1)) }
+        let maxEnergy = 4 * hBar * hBar / (mass * grid.dx * grid.dx) + maxPotential
+        return 0.9 * 2 * hBar / maxEnergy
+    }
+
+    /// - Parameters:
+    ///   - grid: Grid shared by both coordinates; the walls sit at xMin − dx and xMax
+    ///   - mass: Particle mass in kg
+    ///   - potential: One-body potential energy in Joules at every grid point
+    ///   - symmetry: Bosonic or fermionic exchange symmetry
+    ///   - interaction: Pair interaction W(d) in Joules as a function of the separation in meters
+    init(
+        grid: QuantumGrid, mass: Double, potential: [Double], symmetry: ExchangeSymmetry,
+        interaction: (Double) -> Double
+    ) {
+        precondition(potential.count == grid.count, "Potential must match grid size")
+        self.grid = grid
+        self.mass = mass
+        self.potential = potential
+        self.symmetry = symmetry
+
+        let n = grid.count
+        let pairInteraction = (0..<n).map { interaction(Double($0) * grid.dx) }
+        var packed = [Double]()
+        packed.reserveCapacity(n * (n + 1) / 2)
+        for i in 0..<n {
+            for j in i..<n {
+                packed.append(potential[i] + potential[j] + pairInteraction[j - i])
+            }
+        }
+        self.pairPotential = packed
+    }
+
+    // MARK: - States
+
+    /// Normalized (anti)symmetrized product φ_a(x₁)φ_b(x₂) ± φ_b(x₁)φ_a(x₂)
+    func makeState(first: ComplexArray, second: ComplexArray) -> TwoParticleState {
+        precondition(first.count == gridCount && second.count == gridCount, "Orbitals must match grid size")
+
+        var state = TwoParticleState(gridCount: gridCount, symmetry: symmetry)
+        var index = 0
+        for i in 0..<gridCount {
+            for j in i..<gridCount {
+                let value = first[i] * second[j] + symmetry.sign * (first[j] * second[i])
+                state.real[index] = value.real
+                state.imaginary[index] = value.imaginary
+                index += 1
+            }
+        }
+
+        let currentNorm = norm(of: state)
+        precondition(currentNorm > 0, "Orbitals give a vanishing (anti)symmetrized state")
+        var scale = 1 / currentNorm
+        let length = vDSP_Length(state.real.count)
+        state.real.withUnsafeMutableBufferPointer { vDSP_vsmulD($0.baseAddress!, 1, &scale, $0.baseAddress!, 1, length) }
+        state.imaginary.withUnsafeMutableBufferPointer {
+            vDSP_vsmulD($0.baseAddress!, 1, &scale, $0.baseAddress!, 1, length)
+        }
+        return state
+    }
+
+    // MARK: - Observables
+
+    /// √∫∫|ψ|² dx₁dx₂ over the full square: off-diagonal entries count twice
+    func norm(of state: TwoParticleState) -> Double {
+        var diagonal = 0.0
+        for i in 0..<gridCount {
+            let index = TwoParticleState.offset(row: i, gridCount: gridCount)
+            diagonal += state.real[index] * state.real[index] + state.imaginary[index] * state.imaginary[index]
+        }
+
+        var realSum = 0.0
+        var imaginarySum = 0.0
+        vDSP_svesqD(state.real, 1, &realSum, vDSP_Length(state.real.count))
+        vDSP_svesqD(state.imaginary, 1, &imaginarySum, vDSP_Length(state.imaginary.count))
+        return sqrt(2 * (realSum + imaginarySum) - diagonal) * grid.dx
+    }
+
+    /// One-body density ρ(x) = ∫|ψ(x, x₂)|² dx₂ (integrates to 1)
+    func oneBodyDensity(_ state: TwoParticleState) -> [Double] {
+        var density = [Double](repeating: 0, count: gridCount)
+        var index = 0
+        for i in 0..<gridCount {
+            for j in i..<gridCount {
+                let probability = state.real[index] * state.real[index] + state.imaginary[index] * state.imaginary[index]
+                density[i] += probability * grid.dx
+                if j != i {
+                    density[j] += probability * grid.dx
+                }
+                index += 1
+            }
+        }
+        return density
+    }
+
+    // MARK: - Propagation
+
+    /// Advance the state by `steps` leapfrog steps of size `dt` (at most `stableTimeStep`)
+    /// - Returns: One-body density at the final time, accumulated during the closing half step
+    @discardableResult
+    func propagate(_ state: inout TwoParticleState, timeStep dt: Double, steps: Int) -> [Double] {
+        precondition(state.gridCount == gridCount && state.symmetry == symmetry, "State does not match propagator")
+        guard steps > 0 else { return oneBodyDensity(state) }
+
+        let n = gridCount
+        let factor = dt / hBar
+        let bands = (n + tileSize.rows - 1) / tileSize.rows
+        var partialDensity = [Double](repeating: 0, count: bands * n)
+        let zeros = [Double](repeating: 0, count: n)
+
+        state.real.withUnsafeMutableBufferPointer { realBuffer in
+            state.imaginary.withUnsafeMutableBufferPointer { imagBuffer in
+                pairPotential.withUnsafeBufferPointer { vBuffer in
+                    zeros.withUnsafeBufferPointer { zeroBuffer in
+                        partialDensity.withUnsafeMutableBufferPointer { densityBuffer in
+                            let re = realBuffer.baseAddress!
+                            let im = imagBuffer.baseAddress!
+                            let sweep = Sweep(
+                                gridCount: n, sign: symmetry.sign,
+                                coupling: -hBar * hBar / (2 * mass * grid.dx * grid.dx),
+                                potential: vBuffer.baseAddress!, zeros: zeroBuffer.baseAddress!,
+                                tileSize: tileSize)
+
+                            // Open the stagger: Im(ψ) to t + dt/2
+                            sweep.run(target: im, source: re, scale: -0.5 * factor)
+
+                            for _ in 1..<steps {
+                                sweep.run(target: re, source: im, scale: factor)
+                                sweep.run(target: im, source: re, scale: -factor)
+                            }
+
+                            // Last step closes with a half step of Im(ψ) and collects the density
+                            sweep.run(target: re, source: im, scale: factor)
+                            sweep.run(
+                                target: im, source: re, scale: -0.5 * factor,
+                                density: (densityBuffer.baseAddress!, re, grid.dx))
+                        }
+                    }
+                }
+            }
+        }
+
+        // Reduce the per-band partial densities
+        var density = [Double](repeating: 0, count: n)
+        partialDensity.withUnsafeBufferPointer { partial in
+            for band in 0..<bands {
+                vDSP_vaddD(density, 1, partial.baseAddress! + band * n, 1, &density, 1, vDSP_Length(n))
+            }
+        }
+        return density
+    }
+
+    // MARK: - Private Methods
+
+    /// One tiled in-place half update target += scale · H source on the packed triangle
+    private struct Sweep {
+        let gridCount: Int
+        let sign: Double
+        let coupling: Double
+        let potential: UnsafePointer<Double>
+        let zeros: UnsafePointer<Double>
+        let tileSize: (rows: Int, columns: Int)
+
+        func run(
+            target: UnsafeMutablePointer<Double>, source: UnsafeMutablePointer<Double>, scale: Double,
+            density: (buffer: UnsafeMutablePointer<Double>, other: UnsafeMutablePointer<Double>, dx: Double)? = nil
+        ) {
+            let n = gridCount
+            let bands = (n + tileSize.rows - 1) / tileSize.rows
+
+            WorkerPool.shared.concurrentPerform(iterations: bands) { band in
+                let firstRow = band * tileSize.rows
+                let lastRow = min(firstRow + tileSize.rows, n)
+                let bandDensity = density.map { $0.buffer + band * n }
+
+                for tileStart in stride(from: firstRow, to: n, by: tileSize.columns) {
+                    let tileEnd = min(tileStart + tileSize.columns, n)
+
+                    for i in firstRow..<lastRow where i < tileEnd {
+                        let rowOffset = TwoParticleState.offset(row: i, gridCount: n)
+                        // Bases indexed by the absolute column j
+                        let current = UnsafePointer(source) + rowOffset - i
+                        let above = i > 0
+                            ? UnsafePointer(source) + TwoParticleState.offset(row: i - 1, gridCount: n) - (i - 1)
+                            : zeros
+                        let below = UnsafePointer(source) + rowOffset + (n - i) - (i + 1)
+                        let output = target + rowOffset - i
+                        let v = potential + rowOffset - i
+
+                        // Diagonal and last column need the reflected or wall neighbours
+                        func edge(_ j: Int) {
+                            let up = i > 0 ? above[j] : 0
+                            let right = j + 1 < n ? current[j + 1] : 0
+                            let down: Double
+                            let left: Double
+                            if j == i {
+                                down = i + 1 < n ? sign * current[i + 1] : 0
+                                left = i > 0 ? sign * above[i] : 0
+                            } else {
+                                down = below[j]
+                                left = current[j - 1]
+                            }
+                            output[j] += scale
+                                * (coupling * (up + down + left + right - 4 * current[j]) + v[j] * current[j])
+                        }
+
+                        let start = max(i, tileStart)
+                        if start == i {
+                            edge(i)
+                        }
+
+                        // Interior: all four neighbours are stored in rows i − 1, i, i + 1
+                        let interiorStart = max(i + 1, tileStart)
+                        let interiorEnd = min(tileEnd, n - 1)
+                        if interiorStart < interiorEnd {
+                            for j in interiorStart..<interiorEnd {
+                                let laplacian = above[j] + below[j] + current[j - 1] + current[j + 1] - 4 * current[j]
+                                output[j] += scale * (coupling * laplacian + v[j] * current[j])
+                            }
+                        }
+
+                        if tileEnd == n && n - 1 > i {
+                            edge(n - 1)
+                        }
+
+                        // One-body density from the updated pair (Re from `other`, Im just written)
+                        if let rho = bandDensity, let density = density {
+                            let re = UnsafePointer(density.other) + rowOffset - i
+                            for j in start..<tileEnd {
+                                let probability = (re[j] * re[j] + output[j] * output[j]) * density.dx
+                                rho[i] += probability
+                                if j != i {
+                                    rho[j] += probability
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,136 @@
+import Foundation
+
+/// Fixed set of simulation worker threads.
+///
+/// The threads are created once at `ThreadConfiguration.workerQoS` and configure themselves as
+/// they start, so every thread that ever runs simulation work carries the worker affinity tag.
+/// Jobs from `SupersedingJobQueue` and the data-parallel loops of the kernels both run here
+/// rather than on GCD's shared threads, which also serve the UI and the audio engine.
+final class WorkerPool {
+    static let shared = WorkerPool(threadCount: ProcessInfo.processInfo.activeProcessorCount)
+
+    /// Number of worker threads
+    let threadCount: Int
+
+    /// Iterations of one `concurrentPerform` call
+    private final class Batch {
+        let iterations: Int
+        /// Cleared by the caller once every participant has left
+        var body: ((Int) -> Void)?
+        /// Next unclaimed iteration
+        var next = 0
+        /// Threads currently claiming iterations, the caller included
+        var participants = 0
+
+        init(iterations: Int, body: @escaping (Int) -> Void) {
+            self.iterations = iterations
+            self.body = body
+        }
+    }
+
+    private let condition = NSCondition()
+    private var jobs: [() -> Void] = []
+    /// Batches with unclaimed iterations, newest last
+    private var batches: [Batch] = []
+
+    init(threadCount: Int) {
+        self.threadCount = max(1, threadCount)
+
+        // The threads keep the pool alive; a pool lives for the rest of the process
+        for index in 0..<self.threadCount {
+            let thread = Thread {
+                self.run()
+            }
+            thread.name = "QuantumWaveform.worker.\(index)"
+            thread.qualityOfService = ThreadConfiguration.shared.workerQoS
+            thread.start()
+        }
+    }
+
+    /// Run `job` on the next free worker
+    func async(_ job: @escaping () -> Void) {
+        condition.lock()
+        jobs.append(job)
+        // Callers of concurrentPerform wait on the same condition, so wake everyone
+        condition.broadcast()
+        condition.unlock()
+    }
+
+    /// Drop-in for `DispatchQueue.concurrentPerform` on the worker threads.
+    ///
+    /// The calling thread claims iterations too, so a call from inside a job or from inside
+    /// another loop's body completes even when every worker is busy. Idle workers join while
+    /// unclaimed iterations remain, and the call returns once the last of them has finished.
+    func concurrentPerform(iterations: Int, execute body: (Int) -> Void) {
+        guard iterations > 1 else {
+            if iterations == 1 {
+                body(0)
+            }
+            return
+        }
+
+        withoutActuallyEscaping(body) { body in
+            let batch = Batch(iterations: iterations, body: body)
+            condition.lock()
+            batches.append(batch)
+            batch.participants += 1
+            condition.broadcast()
+            condition.unlock()
+
+            work(on: batch)
+
+            condition.lock()
+            while batch.participants > 0 {
+                condition.wait()
+            }
+            batch.body = nil
+            condition.unlock()
+        }
+    }
+
+    // MARK: - Private Methods
+
+    private func run() {
+        ThreadConfiguration.shared.configureWorkerThread()
+
+        condition.lock()
+        while true {
+            if let batch = batches.last {
+                batch.participants += 1
+                condition.unlock()
+                work(on: batch)
+                condition.lock()
+            } else if !jobs.isEmpty {
+                let job = jobs.removeFirst()
+                condition.unlock()
+                ThreadConfiguration.shared.applyPendingAudioThreadConfiguration()
+                job()
+                condition.lock()
+            } else {
+                condition.wait()
+            }
+        }
+    }
+
+    /// Claim and run iterations of `batch` until none are left, then leave it.
+    /// The calling thread must already be counted in `participants`.
+    private func work(on batch: Batch) {
+        condition.lock()
+        while batch.next < batch.iterations {
+            let index = batch.next
+            batch.next += 1
+            if batch.next == batch.iterations {
+                batches.removeAll { $0 === batch }
+            }
+            condition.unlock()
+            batch.body?(index)
+            condition.lock()
+        }
+
+        batch.participants -= 1
+        if batch.participants == 0 {
+            condition.broadcast()
+        }
+        condition.unlock()
+    }
+}
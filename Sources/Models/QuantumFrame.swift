@@ -0,0 +1,133 @@
+import Accelerate
+import Foundation
+
+/// Immutable snapshot of the wave function on the simulator grid at one time.
+///
+/// The simulator, view model and renderers share a frame by reference. The real part, imaginary
+/// part and normalized density are filled once into a single cache-line aligned block (structure
+/// of arrays). Single-precision and interleaved (re, im) views are derived on first request
+/// and stay with the frame, so later consumers neither convert nor copy. Each float component
+/// starts on a page boundary and spans whole pages, so Metal can wrap it in place with
+/// `makeBuffer(bytesNoCopy:)`.
+///
+/// Views point into the frame's storage and are valid for as long as the frame is alive.
+final class QuantumFrame {
+    enum Component: Int, CaseIterable {
+        case real
+        case imaginary
+        /// |ψ|² normalized to unit sum
+        case density
+    }
+
+    /// Simulation time of the snapshot
+    let time: Double
+    /// Samples per component
+    let count: Int
+
+    private static let cacheLineSize = 64
+    private static let pageSize = Int(getpagesize())
+
+    private let storage: UnsafeMutablePointer<Double>
+    private let lock = NSLock()
+    private var floatStorage: UnsafeMutableRawPointer?
+    private var interleavedStorage: UnsafeMutablePointer<DSPDoubleComplex>?
+
+    /// Bytes from one float component to the next, a whole number of pages
+    private var floatComponentLength: Int {
+        let bytes = max(1, count) * MemoryLayout<Float>.stride
+        return (bytes + QuantumFrame.pageSize - 1) / QuantumFrame.pageSize * QuantumFrame.pageSize
+    }
+
+    init(time: Double, real: [Double], imaginary: [Double]) {
+        precondition(real.count == imaginary.count, "Real and imaginary parts differ in length")
+
+        self.time = time
+        self.count = real.count
+
+        let raw = UnsafeMutableRawPointer.allocate(
+            byteCount: max(1, 3 * count) * MemoryLayout<Double>.stride, alignment: QuantumFrame.cacheLineSize)
+        storage = raw.bindMemory(to: Double.self, capacity: max(1, 3 * count))
+        guard count > 0 else { return }
+
+        let re = storage
+        let im = storage + count
+        let density = storage + 2 * count
+        re.initialize(from: real, count: count)
+        im.initialize(from: imaginary, count: count)
+
+        // |ψ|² = re² + im², normalized to unit sum like the simulator's density grid
+        let length = vDSP_Length(count)
+        vDSP_vsqD(re, 1, density, 1, length)
+        vDSP_vmaD(im, 1, im, 1, density, 1, density, 1, length)
+        var sum = 0.0
+        vDSP_sveD(density, 1, &sum, length)
+        if sum > 0 {
+            vDSP_vsdivD(density, 1, &sum, density, 1, length)
+        }
+    }
+
+    deinit {
+        storage.deinitialize(count: 3 * count)
+        storage.deallocate()
+        floatStorage?.deallocate()
+        interleavedStorage?.deallocate()
+    }
+
+    // MARK: - Views
+
+    var real: UnsafeBufferPointer<Double> {
+        return doubles(.real)
+    }
+
+    var imaginary: UnsafeBufferPointer<Double> {
+        return doubles(.imaginary)
+    }
+
+    var density: UnsafeBufferPointer<Double> {
+        return doubles(.density)
+    }
+
+    /// Double-precision view of one component
+    func doubles(_ component: Component) -> UnsafeBufferPointer<Double> {
+        return UnsafeBufferPointer(start: storage + component.rawValue * count, count: count)
+    }
+
+    /// Single-precision view of one component (all three are converted together on first use)
+    func floats(_ component: Component) -> UnsafeBufferPointer<Float> {
+        let bytes = floatBytes(component)
+        return UnsafeBufferPointer(start: bytes.pointer.assumingMemoryBound(to: Float.self), count: count)
+    }
+
+    /// Page-aligned bytes of one single-precision component, padded to whole pages
+    func floatBytes(_ component: Component) -> (pointer: UnsafeMutableRawPointer, length: Int) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        if floatStorage == nil {
+            let stride = floatComponentLength
+            let raw = UnsafeMutableRawPointer.allocate(
+                byteCount: stride * Component.allCases.count, alignment: QuantumFrame.pageSize)
+            raw.initializeMemory(as: UInt8.self, repeating: 0, count: stride * Component.allCases.count)
+            for source in Component.allCases {
+                let destination = (raw + source.rawValue * stride).assumingMemoryBound(to: Float.self)
+                vDSP_vdpsp(storage + source.rawValue * count, 1, destination, 1, vDSP_Length(count))
+            }
+            floatStorage = raw
+        }
+        return (floatStorage! + component.rawValue * floatComponentLength, floatComponentLength)
+    }
+
+    /// Interleaved (re, im) pairs, built on first use
+    var interleaved: UnsafeBufferPointer<DSPDoubleComplex> {
+        lock.lock()
+        defer { lock.unlock() }
+
+        if interleavedStorage == nil {
+            let pairs = UnsafeMutablePointer<DSPDoubleComplex>.allocate(capacity: max(1, count))
+            var split = DSPDoubleSplitComplex(realp: storage, imagp: storage + count)
+            vDSP_ztocD(&split, 1, pairs, 2, vDSP_Length(count))
+            interleavedStorage = pairs
+        }
+        return UnsafeBufferPointer(start: interleavedStorage, count: count)
+    }
+}
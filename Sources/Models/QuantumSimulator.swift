@@ -24,6 +24,8 @@ class QuantumSimulator {
     private var energyLevel: Int = 1
     private var time: Double = 0.0  // Simulation time
     private var potentialHeight: Double = 0.0  // For barrier/well height
+    private var drivingStrength: Double = 0.0  // Barrier modulation depth or dipole field (V/m)
+    private var drivingFrequency: Double = 0.0  // Angular frequency of the drive (rad/s)
 
     // Spatial grid for simulation
     private var xMin: Double = -20e-9  // -20 nm
@@ -34,7 +36,14 @@ class QuantumSimulator {
     // Cached calculation results
     private var cachedWaveFunction: [Complex] = []
     private var cachedProbabilityDensity: [Double] = []
-    private var needsRecalculation: Bool = true
+    private var needsRecalculation: Bool = true {
+        didSet {
+            if needsRecalculation {
+                cachedFrame = nil
+            }
+        }
+    }
+    private var cachedFrame: QuantumFrame?
 
     // MARK: - Performance Optimization
 
@@ -158,6 +167,36 @@ class QuantumSimulator {
         updateSpatialGrid()
     }
 
+    /// Independent simulator with the same parameters and clock, for recomputing off the
+    /// thread that owns this one. Caches are not shared; the copy rebuilds what it reads.
+    func copy() -> QuantumSimulator {
+        let copy = QuantumSimulator()
+        copy.systemType = systemType
+        copy.particleMass = particleMass
+        copy.energyLevel = energyLevel
+        copy.time = time
+        copy.potentialHeight = potentialHeight
+        copy.drivingStrength = drivingStrength
+        copy.drivingFrequency = drivingFrequency
+        copy.xMin = xMin
+        copy.xMax = xMax
+        copy.gridPoints = gridPoints
+        copy.spatialGrid = spatialGrid
+        copy.currentTime = currentTime
+        copy.timeStepSize = timeStepSize
+        copy.isAnimating = isAnimating
+        return copy
+    }
+
+    /// Take over the clock of `other`, which kept running while this copy was recomputed
+    func adoptClock(of other: QuantumSimulator) {
+        guard other.time != time || other.currentTime != currentTime else { return }
+        time = other.time
+        currentTime = other.currentTime
+        isDirty = true
+        needsRecalculation = true
+    }
+
     // MARK: - Public Methods
 
     func setSystemType(_ type: QuantumSystemType) {
@@ -203,6 +242,21 @@ class QuantumSimulator {
         needsRecalculation = true
     }
 
+    /// Configure the time-dependent drive used by `makeDrivenPropagator`
+    /// - Parameters:
+    ///   - strength: Relative barrier modulation depth for the free particle; dipole field
+    ///     amplitude in V/m for the bound systems
+    ///   - angularFrequency: Drive angular frequency in rad/s
+    func setDriving(strength: Double, angularFrequency: Double) {
+        drivingStrength = strength
+        drivingFrequency = angularFrequency
+    }
+
+    /// Change only the drive frequency (e.g. to follow the audio frequency)
+    func setDrivingFrequency(_ angularFrequency: Double) {
+        drivingFrequency = angularFrequency
+    }
+
     func getSpatialGrid() -> [Double] {
         return spatialGrid
     }
@@ -223,6 +277,22 @@ class QuantumSimulator {
     }
 
     func getExpectedEnergy() -> Double {
+        return expectedEnergy(level: energyLevel)
+    }
+
+    /// Whether |ψ|² is constant in time: a single undriven eigenstate only advances its global phase
+    var isStationary: Bool {
+        return systemType != .freeParticle && drivingStrength == 0
+    }
+
+    /// Level model of the current system (levels 1…levelCount, unit relative dipoles)
+    /// for driven transition dynamics with `RabiMapSolver`
+    func makeLevelSystem(levelCount: Int) -> NLevelSystem {
+        return NLevelSystem(energies: (1...max(2, levelCount)).map { expectedEnergy(level: $0) })
+    }
+
+    /// Energy of level n for the current system
+    private func expectedEnergy(level: Int) -> Double {
         switch systemType {
         case .freeParticle:
             // E = p²/2m = (ħk)²/2m where k = 2π/λ
@@ -233,7 +303,7 @@ class QuantumSimulator {
         case .potentialWell:
             // E = (n²π²ħ²)/(2mL²) for infinite well of width L
             let wellWidth = xMax - xMin
-            return Double(energyLevel * energyLevel) * Double.pi * Double.pi * hBar * hBar
+            return Double(level * level) * Double.pi * Double.pi * hBar * hBar
                 / (2 * particleMass * wellWidth * wellWidth)
 
         case .harmonicOscillator:
@@ -241,14 +311,14 @@ class QuantumSimulator {
             // We use a nominal spring constant to visualize properly
             let springConstant = 1e-8  // Arbitrary for visualization
             let omega = sqrt(springConstant / particleMass)
-            return (Double(energyLevel) - 0.5) * hBar * omega
+            return (Double(level) - 0.5) * hBar * omega
 
         case .hydrogenAtom:
             // E = -Ry/n² where Ry is Rydberg energy
             let rydberg =
                 electronMass * pow(electronCharge, 4)
                 / (8 * pow(vacuumPermittivity, 2) * pow(hBar, 2))
-            return -rydberg / Double(energyLevel * energyLevel)
+            return -rydberg / Double(level * level)
         }
     }
 
@@ -622,7 +692,28 @@ class QuantumSimulator {
         return calculateWaveFunction(at: currentTime)
     }
 
-    /// Get the phase of the wave function across the grid
+    /// Shared snapshot of the wave function at the current time, rebuilt only when the time or
+    /// a parameter changes; hand it to the renderers instead of the component arrays
+    func currentFrame() -> QuantumFrame {
+        if let frame = cachedFrame, frame.time == currentTime {
+            return frame
+        }
+
+        let (real, imaginary) = getWaveFunctionComponents()
+        let frame = QuantumFrame(time: currentTime, real: real, imaginary: imaginary)
+        cachedFrame = frame
+        return frame
+    }
+
+    /// Probability density and current j = (ħ/m) Im(ψ*∂ψ) across the grid from one fused pass
+    /// (the ends wrap, which is harmless because every analytic state vanishes there)
+    func getProbabilityCurrentGrid() -> (density: [Double], current: [Double]) {
+        let (real, imaginary) = getWaveFunctionComponents()
+        let dx = (xMax - xMin) / Double(max(gridPoints - 1, 1))
+        return ComplexArray(real: real, imaginary: imaginary).densityAndCurrent(dx: dx, mass: particleMass)
+    }
+
+    /// Get the unwrapped phase of the wave function across the grid
     func getPhaseGrid() -> [Double] {
         // Check cache first
         if let cached = phaseCache[currentTime] {
@@ -630,16 +721,693 @@ class QuantumSimulator {
         }
 
         // Recalculate and cache
+        let phases = getPhaseField().unwrapped
+        phaseCache[currentTime] = phases
+        return phases
+    }
+
+    /// Get the local wave number ∂φ/∂x (rad/m) across the grid
+    func getLocalWaveNumberGrid() -> [Double] {
+        return getPhaseField().localWaveNumber
+    }
+
+    /// Wrapped and unwrapped phase plus local wave number of the current wave function
+    func getPhaseField() -> PhaseField {
         let (real, imaginary) = getWaveFunctionComponents()
-        var phases: [Double] = []
+        let dx = (xMax - xMin) / Double(max(gridPoints - 1, 1))
+        return ComplexArray(real: real, imaginary: imaginary).phaseField(dx: dx)
+    }
+
+    // MARK: - Time Propagation
+
+    /// Create a periodic propagation grid spanning the current system's domain
+    /// - Parameter pointCount: Number of grid cells (a power of two for split-operator engines)
+    func makePropagationGrid(pointCount: Int = 1024) -> QuantumGrid {
+        return QuantumGrid(xMin: xMin, xMax: xMax, count: pointCount)
+    }
+
+    /// Create a box grid for engines with Dirichlet walls one cell beyond each end: the
+    /// `pointCount` interior points of the domain, so the walls sit exactly at xMin and xMax
+    func makeBoxGrid(pointCount: Int) -> QuantumGrid {
+        let dx = (xMax - xMin) / Double(pointCount + 1)
+        return QuantumGrid(xMin: xMin + dx, xMax: xMax, count: pointCount)
+    }
 
-        // Calculate phase at each point
-        for i in 0..<min(real.count, imaginary.count) {
-            phases.append(atan2(imaginary[i], real[i]))
+    /// Potential energy (in Joules) of the current system at position `x`
+    func potentialEnergy(at x: Double) -> Double {
+        switch systemType {
+        case .freeParticle:
+            // Same barrier placement as the analytic tunneling model
+            let barrierPosition = (xMax - xMin) * 0.6 + xMin
+            let barrierWidth = (xMax - xMin) * 0.05
+            return x > barrierPosition && x < barrierPosition + barrierWidth
+                ? potentialHeight * electronCharge : 0
+
+        case .potentialWell:
+            // Walls coincide with the grid edges; the interior is field-free
+            return 0
+
+        case .harmonicOscillator:
+            let springConstant = 1e-8  // Arbitrary for visualization
+            return 0.5 * springConstant * x * x
+
+        case .hydrogenAtom:
+            // Softened Coulomb potential to avoid the r = 0 singularity
+            let coulomb = electronCharge * electronCharge / (4 * Double.pi * vacuumPermittivity)
+            let softening = 0.1 * bohrRadius
+            return -coulomb / sqrt(x * x + softening * softening)
         }
+    }
 
-        phaseCache[currentTime] = phases
-        return phases
+    /// Sample the current system's potential energy (in Joules) on a propagation grid
+    func makePotential(on grid: QuantumGrid) -> [Double] {
+        return grid.positions.map { potentialEnergy(at: $0) }
+    }
+
+    /// Sample the current system's t = 0 wave function on a propagation grid (normalized)
+    /// - Parameter level: Energy level of the bound systems (defaults to the current level)
+    func makeInitialState(on grid: QuantumGrid, level: Int? = nil) -> ComplexArray {
+        var state = ComplexArray(count: grid.count)
+
+        for i in 0..<grid.count {
+            state[i] = initialWaveFunction(at: grid.position(at: i), level: level ?? energyLevel)
+        }
+
+        state.normalize(dx: grid.dx)
+        return state
+    }
+
+    /// Unnormalized t = 0 wave function of the current system at position `x`
+    private func initialWaveFunction(at x: Double) -> Complex {
+        return initialWaveFunction(at: x, level: energyLevel)
+    }
+
+    private func initialWaveFunction(at x: Double, level: Int) -> Complex {
+        let value: (real: Double, imaginary: Double)
+
+        switch systemType {
+        case .freeParticle:
+            let k0 = 2 * Double.pi / calculateDeBroglieWavelength()
+            value = QuantumMath.gaussianWavePacket(
+                x: x, x0: xMin + (xMax - xMin) * 0.25, k0: k0,
+                sigma: (xMax - xMin) * 0.05, t: 0, mass: particleMass)
+
+        case .potentialWell:
+            value = QuantumMath.infiniteSquareWell(
+                x: x - xMin, L: xMax - xMin, n: level, t: 0, mass: particleMass)
+
+        case .harmonicOscillator:
+            let springConstant = 1e-8  // Arbitrary for visualization
+            value = QuantumMath.harmonicOscillator(
+                x: x, n: level - 1, omega: sqrt(springConstant / particleMass), t: 0,
+                mass: particleMass)
+
+        case .hydrogenAtom:
+            value = QuantumMath.hydrogenAtomRadial(r: abs(x), n: level, l: 0, t: 0)
+        }
+
+        return Complex(real: value.real, imaginary: value.imaginary)
+    }
+
+    /// Build a split-operator propagator for the current system
+    func makeSplitOperatorPropagator(pointCount: Int = 1024) -> SplitOperatorPropagator {
+        let grid = makePropagationGrid(pointCount: pointCount)
+        return SplitOperatorPropagator(
+            grid: grid, mass: particleMass, potential: makePotential(on: grid))
+    }
+
+    /// Build an explicit Visscher leapfrog propagator for the current system.
+    /// Steps must not exceed the propagator's `stableTimeStep`.
+    func makeVisscherPropagator(pointCount: Int = 1024) -> VisscherPropagator {
+        let grid = makePropagationGrid(pointCount: pointCount)
+        return VisscherPropagator(grid: grid, mass: particleMass, potential: makePotential(on: grid))
+    }
+
+    /// Time-dependent potential of the current system under the configured drive.
+    /// The free particle's barrier is modulated as V_b(x)(1 + s·sin ωt); the bound systems are
+    /// driven by a dipole coupling e·x·E₀ sin ωt about the domain center.
+    func makeDrivenPotential(on grid: QuantumGrid) -> DrivenPotential {
+        let staticPart = makePotential(on: grid)
+        let profile: [Double]
+
+        switch systemType {
+        case .freeParticle:
+            profile = staticPart
+        case .potentialWell, .harmonicOscillator, .hydrogenAtom:
+            let center = (xMin + xMax) / 2
+            profile = grid.positions.map { electronCharge * ($0 - center) }
+        }
+
+        let drive = DrivenPotential.Term(
+            profile: profile,
+            amplitude: DrivenPotential.sinusoidal(amplitude: drivingStrength, angularFrequency: drivingFrequency))
+        return DrivenPotential(staticPart: staticPart, terms: [drive])
+    }
+
+    /// Build a propagator for the driven system
+    func makeDrivenPropagator(
+        pointCount: Int = 1024, scheme: DrivenPropagator.Scheme = .commutatorFree4
+    ) -> DrivenPropagator {
+        let grid = makePropagationGrid(pointCount: pointCount)
+        return DrivenPropagator(
+            grid: grid, mass: particleMass, potential: makeDrivenPotential(on: grid), scheme: scheme)
+    }
+
+    /// Build a co-moving-frame propagator for the free-particle packet.
+    /// The carrier e^{ik₀x} is factored out, so the window only needs to resolve the envelope.
+    /// With a barrier, the reflected wave at -k₀ must be representable too, so the grid is refined
+    /// until it resolves envelope wave numbers up to 2k₀ + 8/σ; reflected density then leaves
+    /// through the trailing window edge and is reported in `State.escapedNorm`.
+    /// - Parameters:
+    ///   - pointCount: Envelope grid size (a power of two; far fewer points than the lab grid
+    ///     for a free packet). With a barrier this is a lower bound.
+    ///   - windowWidth: Width of the co-moving window in meters (defaults to 16σ of the packet)
+    func makeGalileanFramePropagator(pointCount: Int = 128, windowWidth: Double? = nil)
+        -> GalileanFramePropagator
+    {
+        let sigma = (xMax - xMin) * 0.05
+        let width = windowWidth ?? 16 * sigma
+        let k0 = 2 * Double.pi / calculateDeBroglieWavelength()
+
+        var count = pointCount
+        if potentialHeight > 0 {
+            let bandLimit = 2 * abs(k0) + 8 / sigma
+            while Double.pi * Double(count) / width < bandLimit {
+                count *= 2
+            }
+        }
+        let grid = QuantumGrid(xMin: -width / 2, xMax: width / 2, count: count)
+
+        // Sample the lab potential directly at the moving window positions
+        let potential: ((Double) -> Double)? =
+            potentialHeight > 0 ? { [weak self] x in self?.potentialEnergy(at: x) ?? 0 } : nil
+
+        return GalileanFramePropagator(
+            grid: grid, mass: particleMass, carrierWaveNumber: k0, potential: potential)
+    }
+
+    /// Initial co-moving state for the free-particle packet, centered on the packet
+    func makeGalileanFrameState(for propagator: GalileanFramePropagator) -> GalileanFramePropagator.State {
+        let x0 = xMin + (xMax - xMin) * 0.25
+        let sigma = (xMax - xMin) * 0.05
+        var envelope = ComplexArray(count: propagator.grid.count)
+
+        // The envelope of the Gaussian packet is known analytically, so sample it without a carrier
+        for i in 0..<propagator.grid.count {
+            let offset = propagator.grid.position(at: i)
+            envelope.real[i] = exp(-offset * offset / (2 * sigma * sigma))
+        }
+        envelope.normalize(dx: propagator.grid.dx)
+
+        return GalileanFramePropagator.State(envelope: envelope, time: 0, frameOrigin: x0)
+    }
+
+    /// Mirror point of the current potential along one axis of the 1D/2D/3D box, or nil if the
+    /// potential is not mirror symmetric along it. The well, oscillator and hydrogen potentials
+    /// are symmetric about the domain center (the nucleus for hydrogen); the free particle's
+    /// barrier breaks the symmetry along x only.
+    func mirrorCenter(axis: Int = 0) -> Double? {
+        switch systemType {
+        case .freeParticle:
+            return axis == 0 ? nil : (xMin + xMax) / 2
+        case .potentialWell, .harmonicOscillator:
+            return (xMin + xMax) / 2
+        case .hydrogenAtom:
+            return 0
+        }
+    }
+
+    /// Build a parity-reduced propagator that simulates only x ≥ c for symmetric systems.
+    /// The parity is detected from the current t = 0 state sampled on the full mirror-symmetric grid.
+    /// - Parameter pointCount: Points in the irreducible half (a power of two)
+    /// - Returns: nil when the potential or the state has no mirror symmetry
+    func makeParityReducedPropagator(pointCount: Int = 512) -> ParityReducedPropagator? {
+        guard let center = mirrorCenter() else { return nil }
+        let halfWidth = xMax - center
+        let fullGrid = QuantumGrid.mirrorSymmetric(center: center, halfWidth: halfWidth, count: 2 * pointCount)
+        guard let parity = Parity.detect(makeInitialState(on: fullGrid), on: fullGrid, center: center) else {
+            return nil
+        }
+
+        let reducedGrid = QuantumGrid.mirrorReduced(center: center, halfWidth: halfWidth, count: pointCount)
+        return ParityReducedPropagator(
+            center: center, halfWidth: halfWidth, count: pointCount, parity: parity, mass: particleMass,
+            potential: makePotential(on: reducedGrid))
+    }
+
+    /// Build a moving-window propagator over a finely resolved lab grid.
+    /// Only the region occupied by the packet is simulated, so the lab grid can be large.
+    func makeMovingWindowPropagator(
+        pointCount: Int = 8192,
+        configuration: MovingWindowPropagator.Configuration = MovingWindowPropagator.Configuration()
+    ) -> MovingWindowPropagator {
+        let grid = makePropagationGrid(pointCount: pointCount)
+        return MovingWindowPropagator(
+            labGrid: grid, mass: particleMass, potential: makePotential(on: grid),
+            configuration: configuration)
+    }
+
+    /// Build a radial propagator for one partial wave of the hydrogen atom.
+    /// The log grid concentrates points near the nucleus, where the bare Coulomb potential is
+    /// used without softening because u(0) = 0 keeps the origin out of the grid.
+    /// - Parameters:
+    ///   - angularMomentum: Partial wave l
+    ///   - pointCount: Number of radial nodes
+    func makeRadialPropagator(angularMomentum: Int = 0, pointCount: Int = 1024) -> RadialPropagator {
+        let grid = RadialGrid.logarithmic(
+            scale: 0.05 * bohrRadius, maxRadius: max(abs(xMin), abs(xMax)), count: pointCount)
+        let coulomb = electronCharge * electronCharge / (4 * Double.pi * vacuumPermittivity)
+
+        return RadialPropagator(
+            grid: grid, angularMomentum: angularMomentum, mass: particleMass,
+            potential: { r in -coulomb / r })
+    }
+
+    /// Hydrogen eigenstate u = r·R_nl for the current energy level (zero if l ≥ n)
+    func makeRadialState(for propagator: RadialPropagator) -> ComplexArray {
+        let n = energyLevel
+        let l = propagator.angularMomentum
+        return propagator.makeState { r in
+            let value = QuantumMath.hydrogenAtomRadial(r: r, n: n, l: l, t: 0)
+            return Complex(real: value.real, imaginary: value.imaginary)
+        }
+    }
+
+    /// Build an (r, z) propagator for cylindrically symmetric versions of the current system.
+    /// The oscillator becomes a cylindrical trap ½k(r² + λz²); hydrogen uses the 3D Coulomb
+    /// potential; the other systems keep their 1D potential along z with free radial motion.
+    /// - Parameters:
+    ///   - radialCount: Radial cells between the axis and the outer radius
+    ///   - axialCount: Axial grid points
+    ///   - axialStiffnessRatio: Trap anisotropy λ = k_z / k_r for the oscillator
+    func makeAxisymmetricPropagator(
+        radialCount: Int = 128, axialCount: Int = 256, axialStiffnessRatio: Double = 1
+    ) -> AxisymmetricPropagator {
+        let axialGrid = makePropagationGrid(pointCount: axialCount)
+        let maxRadius = max(abs(xMin), abs(xMax))
+        let springConstant = 1e-8  // Arbitrary for visualization
+        let coulomb = electronCharge * electronCharge / (4 * Double.pi * vacuumPermittivity)
+
+        return AxisymmetricPropagator(
+            radialCount: radialCount, maxRadius: maxRadius, axialGrid: axialGrid, mass: particleMass
+        ) { r, z in
+            switch systemType {
+            case .harmonicOscillator:
+                return 0.5 * springConstant * (r * r + axialStiffnessRatio * z * z)
+            case .hydrogenAtom:
+                return -coulomb / sqrt(r * r + z * z)
+            case .freeParticle, .potentialWell:
+                return potentialEnergy(at: z)
+            }
+        }
+    }
+
+    /// Initial (r, z) state: the 1D state along z times a Gaussian radial profile
+    /// (the trap ground-state width for the oscillator)
+    func makeAxisymmetricState(for propagator: AxisymmetricPropagator) -> ComplexArray {
+        let springConstant = 1e-8  // Arbitrary for visualization
+        let width =
+            systemType == .harmonicOscillator
+            ? sqrt(hBar / sqrt(springConstant * particleMass)) : (xMax - xMin) * 0.05
+
+        return propagator.makeState { r, z in
+            exp(-r * r / (2 * width * width)) * initialWaveFunction(at: z)
+        }
+    }
+
+    /// Build an ADI propagator on a 2D or 3D box spanning the current domain along every axis.
+    /// The oscillator and hydrogen use their radially symmetric potentials; the free particle
+    /// keeps its barrier as a wall across the x axis; the well is field-free inside the box.
+    /// - Parameters:
+    ///   - dimensions: 2 or 3
+    ///   - pointsPerAxis: Grid points along each axis
+    func makeADIPropagator(dimensions: Int = 2, pointsPerAxis: Int = 256) -> ADIPropagator {
+        let axis = makePropagationGrid(pointCount: pointsPerAxis)
+        return ADIPropagator(
+            axes: [QuantumGrid](repeating: axis, count: dimensions), mass: particleMass,
+            potential: potentialEnergy(x:y:z:))
+    }
+
+    /// Build an ADI propagator over the irreducible part of the box: every axis along which the
+    /// potential is mirror symmetric and the t = 0 state has definite parity keeps only x ≥ c,
+    /// which cuts the work by up to 4× in 2D and 8× in 3D. Parities are detected on a line along
+    /// each axis through an off-center point, which decides them for the separable and radial
+    /// states used here.
+    /// - Parameters:
+    ///   - dimensions: 2 or 3
+    ///   - pointsPerAxis: Points along each reduced axis; full axes get twice as many, so the
+    ///     spacing matches `makeADIPropagator(pointsPerAxis: 2 * pointsPerAxis)`
+    func makeMirrorReducedADIPropagator(dimensions: Int = 2, pointsPerAxis: Int = 128) -> ADIPropagator {
+        var axes = [QuantumGrid]()
+        var parities = [Parity?]()
+        for axis in 0..<dimensions {
+            if let center = mirrorCenter(axis: axis),
+                let parity = mirrorParity(axis: axis, center: center, dimensions: dimensions, count: 2 * pointsPerAxis)
+            {
+                axes.append(.mirrorReduced(center: center, halfWidth: xMax - center, count: pointsPerAxis))
+                parities.append(parity)
+            } else {
+                axes.append(makePropagationGrid(pointCount: 2 * pointsPerAxis))
+                parities.append(nil)
+            }
+        }
+
+        return ADIPropagator(
+            axes: axes, parities: parities, mass: particleMass, potential: potentialEnergy(x:y:z:))
+    }
+
+    /// Parity of the current 2D/3D t = 0 state about `center` along one axis, sampled on a line
+    /// along that axis through an off-center point
+    private func mirrorParity(axis: Int, center: Double, dimensions: Int, count: Int) -> Parity? {
+        let line = QuantumGrid.mirrorSymmetric(center: center, halfWidth: xMax - center, count: count)
+        let offCenter = (xMin + xMax) / 2 + 0.1 * (xMax - xMin)
+
+        var samples = ComplexArray(count: count)
+        for i in 0..<count {
+            var point = [Double](repeating: offCenter, count: 3)
+            point[axis] = line.position(at: i)
+            samples[i] = initialWaveFunction(x: point[0], y: point[1], z: dimensions == 3 ? point[2] : nil)
+        }
+        return Parity.detect(samples, on: line, center: center)
+    }
+
+    /// Potential energy (in Joules) of the current system extended to 2D/3D
+    private func potentialEnergy(x: Double, y: Double, z: Double) -> Double {
+        let r2 = x * x + y * y + z * z
+        switch systemType {
+        case .harmonicOscillator:
+            let springConstant = 1e-8  // Arbitrary for visualization
+            return 0.5 * springConstant * r2
+        case .hydrogenAtom:
+            let coulomb = electronCharge * electronCharge / (4 * Double.pi * vacuumPermittivity)
+            let softening = 0.1 * bohrRadius
+            return -coulomb / sqrt(r2 + softening * softening)
+        case .freeParticle, .potentialWell:
+            return potentialEnergy(at: x)
+        }
+    }
+
+    /// Initial state for an ADI grid: a product of the current level's 1D eigenstates for the
+    /// well and oscillator, R(|r|) for hydrogen, and a transversely Gaussian packet otherwise
+    func makeADIState(for propagator: ADIPropagator) -> ComplexArray {
+        let dimensions = propagator.axes.count
+        return propagator.makeState { x, y, z in
+            initialWaveFunction(x: x, y: y, z: dimensions == 3 ? z : nil)
+        }
+    }
+
+    /// Unnormalized t = 0 wave function of the current system extended to 2D/3D (z nil in 2D)
+    private func initialWaveFunction(x: Double, y: Double, z: Double?) -> Complex {
+        switch systemType {
+        case .freeParticle:
+            // Packet moving along x with a Gaussian transverse profile
+            let sigma = (xMax - xMin) * 0.05
+            let transverse = y * y + (z ?? 0) * (z ?? 0)
+            return exp(-transverse / (2 * sigma * sigma)) * initialWaveFunction(at: x)
+        case .potentialWell, .harmonicOscillator:
+            var value = initialWaveFunction(at: x) * initialWaveFunction(at: y)
+            if let z = z {
+                value = value * initialWaveFunction(at: z)
+            }
+            return value
+        case .hydrogenAtom:
+            let z = z ?? 0
+            return initialWaveFunction(at: sqrt(x * x + y * y + z * z))
+        }
+    }
+
+    /// Build a spinor propagator for the current system in a uniform magnetic field with
+    /// linear spin–orbit coupling (1D or 2D, periodic grid)
+    /// - Parameters:
+    ///   - dimensions: 1 or 2
+    ///   - pointsPerAxis: Grid points along each axis (a power of two)
+    ///   - magneticField: Field B in Tesla; the Zeeman term is μ_B B·σ (g = 2)
+    ///   - spinOrbit: Rashba and Dresselhaus couplings in J·m
+    func makeSpinorPropagator(
+        dimensions: Int = 1, pointsPerAxis: Int = 512, magneticField: SIMD3<Double> = SIMD3(0, 0, 1),
+        spinOrbit: SpinorPropagator.SpinOrbitCoupling = SpinorPropagator.SpinOrbitCoupling()
+    ) -> SpinorPropagator {
+        let axis = makePropagationGrid(pointCount: pointsPerAxis)
+        let axes = [QuantumGrid](repeating: axis, count: dimensions)
+        let bohrMagneton = electronCharge * hBar / (2 * electronMass)
+
+        var potential = [Double]()
+        for y in dimensions == 2 ? axis.positions : [0] {
+            for x in axis.positions {
+                potential.append(dimensions == 2 ? potentialEnergy(x: x, y: y, z: 0) : potentialEnergy(at: x))
+            }
+        }
+
+        return SpinorPropagator(
+            axes: axes, mass: particleMass, potential: potential,
+            zeemanField: [SIMD3<Double>](repeating: bohrMagneton * magneticField, count: potential.count),
+            spinOrbit: spinOrbit)
+    }
+
+    /// Initial spinor: the current system's t = 0 state times a uniform spin (α, β)
+    /// (spin along +x by default, so a field along z makes it precess)
+    func makeSpinorState(
+        for propagator: SpinorPropagator,
+        spin: (up: Complex, down: Complex) = (Complex(real: 1, imaginary: 0), Complex(real: 1, imaginary: 0))
+    ) -> SpinorArray {
+        let axis = propagator.axes[0]
+        let twoDimensional = propagator.axes.count == 2
+
+        var up = ComplexArray(count: propagator.count)
+        var down = ComplexArray(count: propagator.count)
+        for row in 0..<(twoDimensional ? propagator.axes[1].count : 1) {
+            let y = twoDimensional ? propagator.axes[1].position(at: row) : 0
+            for column in 0..<axis.count {
+                let x = axis.position(at: column)
+                let value =
+                    twoDimensional ? initialWaveFunction(x: x, y: y, z: nil) : initialWaveFunction(at: x)
+                up[row * axis.count + column] = value * spin.up
+                down[row * axis.count + column] = value * spin.down
+            }
+        }
+
+        var state = SpinorArray(up: up, down: down)
+        state.normalize(cellVolume: propagator.cellVolume)
+        return state
+    }
+
+    /// Build a 1D Dirac propagator over the current potential.
+    /// - Parameters:
+    ///   - pointCount: Grid size (a power of two)
+    ///   - comptonWavelength: Reduced Compton wavelength ħ/mc to emulate by lowering the speed of
+    ///     light, so relativistic effects resolve on the grid; nil keeps the physical value
+    func makeDiracPropagator(pointCount: Int = 2048, comptonWavelength: Double? = nil) -> DiracPropagator {
+        let grid = makePropagationGrid(pointCount: pointCount)
+        let speedOfLight = comptonWavelength.map { hBar / (particleMass * $0) } ?? QuantumMath.speedOfLight
+        return DiracPropagator(
+            grid: grid, mass: particleMass, potential: makePotential(on: grid), speedOfLight: speedOfLight)
+    }
+
+    /// Positive-energy packet with the free-particle packet's position, width and wave number
+    func makeDiracState(for propagator: DiracPropagator) -> SpinorArray {
+        return propagator.makePositiveEnergyPacket(
+            center: xMin + (xMax - xMin) * 0.25, width: (xMax - xMin) * 0.05,
+            waveNumber: 2 * Double.pi / calculateDeBroglieWavelength())
+    }
+
+    /// Band solver for a Kronig–Penney lattice: barriers of the current height (1 eV if unset)
+    /// filling `barrierFraction` of each cell
+    func makeBandStructureSolver(
+        latticeConstant: Double = 1e-9, barrierFraction: Double = 0.2, samplesPerCell: Int = 128
+    ) -> BlochBandSolver {
+        let height = (potentialHeight > 0 ? potentialHeight : 1.0) * electronCharge
+        let barrierStart = Int((1 - barrierFraction) * Double(samplesPerCell))
+        let cellPotential = (0..<samplesPerCell).map { $0 >= barrierStart ? height : 0 }
+        return BlochBandSolver(cellPotential: cellPotential, latticeConstant: latticeConstant, mass: particleMass)
+    }
+
+    /// Open-system propagator around the split-operator engine.
+    /// - Parameters:
+    ///   - pointCount: Grid size (a power of two)
+    ///   - dephasingRate: Position dephasing rate γ in 1/s (coherence over `coherenceLength` decays at γ/2)
+    ///   - dampingRate: Decay rate κ in 1/s toward the oscillator ground state (0 disables damping)
+    ///   - coherenceLength: Length scale ℓ of the dephasing channel (5% of the domain if nil)
+    func makeLindbladPropagator(
+        pointCount: Int = 1024, dephasingRate: Double, dampingRate: Double = 0, coherenceLength: Double? = nil
+    ) -> LindbladPropagator {
+        return LindbladPropagator(
+            unitary: makeSplitOperatorPropagator(pointCount: pointCount),
+            channels: makeDissipationChannels(
+                dephasingRate: dephasingRate, dampingRate: dampingRate, coherenceLength: coherenceLength))
+    }
+
+    /// Average observables over quantum-jump trajectories of the current system's t = 0 state.
+    /// Takes the same channels as `makeLindbladPropagator`, and the split-operator engine supplies
+    /// the coherent evolution.
+    /// - Parameters:
+    ///   - duration: Total simulated time in seconds
+    ///   - steps: Time steps per trajectory
+    ///   - configuration: Trajectory count, seed, sampling and worker count
+    ///   - observable: Observable of a normalized state; |ψ|² if nil
+    func runQuantumJumpSimulation(
+        duration: Double, steps: Int, pointCount: Int = 1024, dephasingRate: Double, dampingRate: Double = 0,
+        configuration: QuantumJumpEnsemble.Configuration = QuantumJumpEnsemble.Configuration(),
+        observable: ((ComplexArray) -> [Double])? = nil
+    ) -> QuantumJumpEnsemble.Result {
+        let propagator = makeSplitOperatorPropagator(pointCount: pointCount)
+        let ensemble = QuantumJumpEnsemble(
+            unitary: propagator,
+            channels: makeDissipationChannels(dephasingRate: dephasingRate, dampingRate: dampingRate, coherenceLength: nil),
+            configuration: configuration)
+        return ensemble.run(
+            makeInitialState(on: propagator.grid), timeStep: duration / Double(steps), steps: steps,
+            observable: observable)
+    }
+
+    /// Dephasing over `coherenceLength` (5% of the domain if nil) and damping toward the
+    /// oscillator ground state; a zero rate leaves its channel out
+    private func makeDissipationChannels(dephasingRate: Double, dampingRate: Double, coherenceLength: Double?)
+        -> [LindbladPropagator.Channel]
+    {
+        var channels = [LindbladPropagator.Channel]()
+        if dephasingRate > 0 {
+            channels.append(.dephasing(rate: dephasingRate, length: coherenceLength ?? (xMax - xMin) * 0.05))
+        }
+        if dampingRate > 0 {
+            let springConstant = 1e-8  // Arbitrary for visualization
+            let omega = sqrt(springConstant / particleMass)
+            channels.append(.damping(rate: dampingRate, length: sqrt(hBar / (particleMass * omega))))
+        }
+        return channels
+    }
+
+    /// The current system's t = 0 state as a pure density matrix
+    func makeDensityMatrix(for propagator: LindbladPropagator) -> LowRankDensityMatrix {
+        return LowRankDensityMatrix(pureState: makeInitialState(on: propagator.grid))
+    }
+
+    /// Two identical particles in the current potential with a softened Coulomb repulsion
+    /// W(d) = strength · e²/(4πε₀ √(d² + s²)), in a box whose walls are the domain edges
+    /// - Parameters:
+    ///   - pointCount: Points per coordinate (the state stores N(N+1)/2 values)
+    ///   - symmetry: Bosonic or fermionic exchange symmetry
+    ///   - interactionStrength: Fraction of the Coulomb repulsion (0 for non-interacting)
+    ///   - softening: Softening length s in meters
+    func makeTwoParticlePropagator(
+        pointCount: Int = 256, symmetry: ExchangeSymmetry, interactionStrength: Double = 1.0,
+        softening: Double = 0.5e-9
+    ) -> TwoParticlePropagator {
+        let grid = makeBoxGrid(pointCount: pointCount)
+        let coulomb = interactionStrength * electronCharge * electronCharge / (4 * Double.pi * vacuumPermittivity)
+        return TwoParticlePropagator(
+            grid: grid, mass: particleMass, potential: makePotential(on: grid), symmetry: symmetry,
+            interaction: { coulomb / sqrt($0 * $0 + softening * softening) })
+    }
+
+    /// Two packets launched toward each other from the quarter points of the domain
+    func makeTwoParticleState(for propagator: TwoParticlePropagator) -> TwoParticleState {
+        let width = (xMax - xMin) * 0.05
+        let waveNumber = 2 * Double.pi / calculateDeBroglieWavelength()
+
+        func packet(center: Double, waveNumber: Double) -> ComplexArray {
+            var orbital = ComplexArray(count: propagator.gridCount)
+            for j in 0..<propagator.gridCount {
+                let x = propagator.grid.position(at: j)
+                let offset = x - center
+                orbital[j] = exp(-offset * offset / (2 * width * width)) * Complex.fromPolar(r: 1, theta: waveNumber * x)
+            }
+            return orbital
+        }
+
+        return propagator.makeState(
+            first: packet(center: xMin + (xMax - xMin) * 0.25, waveNumber: waveNumber),
+            second: packet(center: xMin + (xMax - xMin) * 0.75, waveNumber: -waveNumber))
+    }
+
+    /// Transmission and reflection of the current system's initial packet from one split-operator run.
+    /// Detectors sit between the launch point and the barrier (45% of the domain) and just past
+    /// the barrier (70%); their time-integrated flux is accumulated after every step.
+    /// T = Φ(70%) and R = 1 − Φ(45%), since the incident packet crosses the first detector once
+    /// and the reflected part crosses it back. The run stops as soon as less than
+    /// `settledProbability` is left between the detectors.
+    /// - Parameters:
+    ///   - duration: Longest simulated time; defaults to the time the packet needs to travel 90%
+    ///     of the domain, long enough for the tails of both parts to clear their detectors. The
+    ///     leading edge of either part wraps around the periodic grid onto the other detector
+    ///     only after about 105%
+    ///   - steps: Number of time steps across `duration`
+    ///   - settledProbability: Probability between the detectors at which scattering is over
+    ///   - cancellation: Stops the run early when a newer request supersedes this one
+    func measureTransmission(
+        pointCount: Int = 1024, duration: Double? = nil, steps: Int = 2000, settledProbability: Double = 1e-4,
+        cancellation: CancellationToken? = nil
+    ) -> (transmission: Double, reflection: Double) {
+        let propagator = makeSplitOperatorPropagator(pointCount: pointCount)
+
+        let speed = 2 * Double.pi * hBar / (particleMass * calculateDeBroglieWavelength())
+        let runTime = duration ?? 0.9 * (xMax - xMin) / speed
+        let dt = runTime / Double(steps)
+
+        let incident = xMin + (xMax - xMin) * 0.45
+        let transmitted = xMin + (xMax - xMin) * 0.7
+        let integrator = EventDrivenIntegrator(
+            propagator: propagator, mass: particleMass, regions: [incident...transmitted],
+            detectorPositions: [incident, transmitted])
+        let result = integrator.run(
+            makeInitialState(on: propagator.grid), timeStep: dt, maxSteps: steps,
+            events: [.regionDepleted(region: 0, below: settledProbability)], cancellation: cancellation)
+
+        let flux = result.finalObservables.integratedFlux
+        return (flux[1], 1 - flux[0])
+    }
+
+    /// Optimal-control problem for the current system driven by a dipole field e·x·u(t) about the
+    /// domain center (the coupling of `makeDrivenPotential`), with u in V/m per slice
+    func makeOptimalControlOptimizer(duration: Double, sliceCount: Int = 400, pointCount: Int = 256)
+        -> OptimalControlOptimizer
+    {
+        let grid = makePropagationGrid(pointCount: pointCount)
+        let center = (xMin + xMax) / 2
+        return OptimalControlOptimizer(
+            grid: grid, mass: particleMass, staticPotential: makePotential(on: grid),
+            profiles: [grid.positions.map { electronCharge * ($0 - center) }], duration: duration,
+            sliceCount: sliceCount)
+    }
+
+    /// Design a field that carries the system from one energy level to another
+    /// - Parameters:
+    ///   - duration: Control time; defaults to ten periods of the transition
+    ///   - configuration: Optimizer settings; the default first step is a field whose dipole
+    ///     energy across the half-domain is a tenth of the transition energy
+    ///   - cancellation: Ends the optimization early when a newer request supersedes this one
+    func optimizeTransitionControl(
+        fromLevel: Int, toLevel: Int, duration: Double? = nil, sliceCount: Int = 400, pointCount: Int = 256,
+        configuration: OptimalControlOptimizer.Configuration? = nil, cancellation: CancellationToken? = nil
+    ) -> OptimalControlOptimizer.Result {
+        let transitionEnergy = max(
+            abs(expectedEnergy(level: toLevel) - expectedEnergy(level: fromLevel)), .leastNormalMagnitude)
+        let optimizer = makeOptimalControlOptimizer(
+            duration: duration ?? 10 * 2 * Double.pi * hBar / transitionEnergy, sliceCount: sliceCount,
+            pointCount: pointCount)
+
+        if let configuration = configuration {
+            optimizer.configuration = configuration
+        } else {
+            optimizer.configuration.initialStepSize = 0.1 * transitionEnergy / (electronCharge * (xMax - xMin) / 2)
+        }
+
+        return optimizer.optimize(
+            from: makeInitialState(on: optimizer.grid, level: fromLevel),
+            to: makeInitialState(on: optimizer.grid, level: toLevel), cancellation: cancellation)
+    }
+
+    /// Propagate the current system's initial state over a long horizon with Parareal.
+    /// The coarse and fine sweeps share one split-operator propagator and differ only in step count.
+    func runPararealSimulation(
+        duration: Double, pointCount: Int = 1024,
+        configuration: PararealIntegrator.Configuration = PararealIntegrator.Configuration(),
+        cancellation: CancellationToken? = nil
+    ) -> PararealIntegrator.Result {
+        let propagator = makeSplitOperatorPropagator(pointCount: pointCount)
+        let integrator = PararealIntegrator(
+            coarse: propagator, fine: propagator, configuration: configuration)
+        return integrator.integrate(
+            makeInitialState(on: propagator.grid), duration: duration, cancellation: cancellation)
     }
 
     // MARK: - Cache Management
@@ -647,6 +1415,7 @@ class QuantumSimulator {
     /// Clear all caches when parameters change
     private func invalidateCache() {
         isDirty = true
+        cachedFrame = nil
         waveFunctionCache.removeAll()
         phaseCache.removeAll()
         probabilityCache.removeAll()
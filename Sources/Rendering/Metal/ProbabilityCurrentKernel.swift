@@ -0,0 +1,121 @@
+import Foundation
+import Metal
+
+/// Encodes the fused `compute_probability_density_current` kernel: |ψ|² and the probability
+/// current in one pass over the wave function, plus time-integrated flux at detector cells.
+/// Detector currents use the spectral weights of `FluxDetectors`, rebuilt when the grid changes.
+class ProbabilityCurrentKernel {
+    /// Grid indices of the detectors
+    let detectorIndices: [UInt32]
+
+    private let device: MTLDevice
+    private let pipeline: MTLComputePipelineState
+    private let indexBuffer: MTLBuffer
+    /// Spectral derivative weights for the grid in `weightGrid`
+    private var weightBuffer: MTLBuffer
+    private var weightGrid: (count: UInt32, spacing: Float)?
+    /// ∫ j dt per detector, accumulated on the GPU
+    let fluxBuffer: MTLBuffer
+
+    /// - Parameter detectorIndices: Grid cells at which flux is integrated (may be empty)
+    init?(detectorIndices: [UInt32]) {
+        guard
+            let device = ShaderManager.shared.device,
+            let pipeline = ShaderManager.shared.createComputePipelineState(
+                function: "compute_probability_density_current")
+        else { return nil }
+
+        // Metal buffers cannot be empty; one unused slot keeps the bindings valid
+        let indices = detectorIndices.isEmpty ? [UInt32(0)] : detectorIndices
+        guard
+            let indexBuffer = device.makeBuffer(
+                bytes: indices, length: MemoryLayout<UInt32>.stride * indices.count, options: []),
+            let fluxBuffer = device.makeBuffer(
+                length: MemoryLayout<Float>.stride * indices.count, options: [.storageModeShared]),
+            let weightBuffer = device.makeBuffer(length: MemoryLayout<Float>.stride, options: [])
+        else { return nil }
+
+        self.detectorIndices = detectorIndices
+        self.device = device
+        self.weightBuffer = weightBuffer
+        self.pipeline = pipeline
+        self.indexBuffer = indexBuffer
+        self.fluxBuffer = fluxBuffer
+        resetFlux()
+    }
+
+    /// Integrated flux per detector (valid once the command buffer has completed)
+    var integratedFlux: [Float] {
+        let pointer = fluxBuffer.contents().bindMemory(to: Float.self, capacity: detectorIndices.count)
+        return Array(UnsafeBufferPointer(start: pointer, count: detectorIndices.count))
+    }
+
+    /// Zero the flux accumulators
+    func resetFlux() {
+        memset(fluxBuffer.contents(), 0, fluxBuffer.length)
+    }
+
+    /// Encode one density/current pass
+    /// - Parameters:
+    ///   - commandBuffer: Command buffer to encode into
+    ///   - waveFunction: `gridSize` ComplexType values
+    ///   - density: `gridSize` floats receiving |ψ|²
+    ///   - current: `gridSize` floats receiving j
+    ///   - parameters: Grid and physical parameters
+    ///   - sampleSpacing: Distance between neighbouring samples in the units of `domain`; L/N for
+    ///     the renderers' half-open sampling, L/(N−1) for simulator grids that include both ends
+    ///   - timeStep: Time represented by this sample, added to the detector integrals as j·dt
+    func encode(
+        into commandBuffer: MTLCommandBuffer, waveFunction: MTLBuffer, density: MTLBuffer, current: MTLBuffer,
+        parameters: QuantumKernelParameters, sampleSpacing: Float, timeStep: Float
+    ) {
+        guard
+            detectorIndices.isEmpty || updateWeights(count: parameters.gridSize, spacing: sampleSpacing),
+            let encoder = commandBuffer.makeComputeCommandEncoder()
+        else { return }
+
+        var params = parameters
+        var detectorCount = UInt32(detectorIndices.count)
+        var dt = timeStep
+        var dx = sampleSpacing
+
+        encoder.setComputePipelineState(pipeline)
+        encoder.setBuffer(waveFunction, offset: 0, index: 0)
+        encoder.setBuffer(density, offset: 0, index: 1)
+        encoder.setBuffer(current, offset: 0, index: 2)
+        encoder.setBytes(&params, length: MemoryLayout<QuantumKernelParameters>.stride, index: 3)
+        encoder.setBuffer(indexBuffer, offset: 0, index: 4)
+        encoder.setBuffer(fluxBuffer, offset: 0, index: 5)
+        encoder.setBytes(&detectorCount, length: MemoryLayout<UInt32>.stride, index: 6)
+        encoder.setBytes(&dt, length: MemoryLayout<Float>.stride, index: 7)
+        encoder.setBytes(&dx, length: MemoryLayout<Float>.stride, index: 8)
+        encoder.setBuffer(weightBuffer, offset: 0, index: 9)
+
+        let gridSize = MTLSize(width: Int(parameters.gridSize), height: 1, depth: 1)
+        let threadGroupSize = MTLSize(
+            width: min(Int(parameters.gridSize), pipeline.maxTotalThreadsPerThreadgroup), height: 1, depth: 1)
+        encoder.dispatchThreads(gridSize, threadsPerThreadgroup: threadGroupSize)
+        encoder.endEncoding()
+    }
+
+    // MARK: - Private Methods
+
+    /// Rebuild the derivative weights for a periodic grid of `count` samples `spacing` apart
+    /// - Returns: Whether `weightBuffer` holds the weights for that grid
+    private func updateWeights(count: UInt32, spacing: Float) -> Bool {
+        if let grid = weightGrid, grid.count == count, grid.spacing == spacing {
+            return true
+        }
+
+        let weights = FluxDetectors.derivativeWeights(count: Int(count), period: Double(count) * Double(spacing))
+            .map { Float($0) }
+        guard
+            !weights.isEmpty,
+            let buffer = device.makeBuffer(
+                bytes: weights, length: MemoryLayout<Float>.stride * weights.count, options: [])
+        else { return false }
+        weightBuffer = buffer
+        weightGrid = (count, spacing)
+        return true
+    }
+}
@@ -0,0 +1,134 @@
+import Foundation
+import Metal
+
+/// Swift mirror of `QuantumParameters` in ShaderTypes.h, bound as `constant QuantumParameters &`
+/// by the quantum compute kernels. Field order and padding must match the C layout (56 bytes).
+struct QuantumKernelParameters {
+    var energyLevel: Float = 0
+    var particleMass: Float = 0
+    var potentialHeight: Float = 0
+    var simulationTime: Float = 0
+    var systemType: Int32 = 0
+    var visualizationType: Int32 = 0
+    var amplitude: Float = 0
+    var frequency: Float = 0
+
+    var gridSize: UInt32
+    var reserved: UInt32 = 0  // vector_float2 is 8-byte aligned
+    var domain: SIMD2<Float>  // min and max domain values
+    var hbar: Float
+    var mass: Float
+}
+
+/// Encodes GPU time steps of the `quantum_evolution` kernel family on an interleaved
+/// complex wave-function buffer.
+class QuantumEvolutionKernel {
+    /// Time-stepping scheme used on the GPU
+    enum Scheme {
+        /// Forward Euler (`quantum_evolution`); fixed internal step, only for previews
+        case euler
+        /// Visscher staggered leapfrog (`quantum_evolution_visscher_real` / `_imag`)
+        case visscher
+    }
+
+    let scheme: Scheme
+
+    private let eulerPipeline: MTLComputePipelineState?
+    private let realPipeline: MTLComputePipelineState?
+    private let imagPipeline: MTLComputePipelineState?
+
+    /// - Parameter scheme: Stepping scheme; pipelines are created through `ShaderManager`
+    init?(scheme: Scheme = .visscher) {
+        self.scheme = scheme
+
+        switch scheme {
+        case .euler:
+            guard let pipeline = ShaderManager.shared.createComputePipelineState(function: "quantum_evolution")
+            else { return nil }
+            eulerPipeline = pipeline
+            realPipeline = nil
+            imagPipeline = nil
+
+        case .visscher:
+            guard
+                let real = ShaderManager.shared.createComputePipelineState(
+                    function: "quantum_evolution_visscher_real"),
+                let imag = ShaderManager.shared.createComputePipelineState(
+                    function: "quantum_evolution_visscher_imag")
+            else { return nil }
+            eulerPipeline = nil
+            realPipeline = real
+            imagPipeline = imag
+        }
+    }
+
+    /// Stable Visscher step for the kernel's parameters (same units as `QuantumKernelParameters`).
+    /// The kinetic bound is grouped like `kinetic_coupling` in the shader, since ħ² underflows Float.
+    static func stableTimeStep(parameters: QuantumKernelParameters, maxPotential: Float, safety: Float = 0.9)
+        -> Float
+    {
+        let dx = (parameters.domain.y - parameters.domain.x) / Float(parameters.gridSize)
+        let maxEnergy = 2 * (parameters.hbar / parameters.mass) / (dx * dx) * parameters.hbar + maxPotential
+        return safety * 2 * parameters.hbar / maxEnergy
+    }
+
+    /// Encode `steps` time steps into one compute pass
+    /// - Parameters:
+    ///   - commandBuffer: Command buffer to encode into
+    ///   - waveFunction: `gridSize` ComplexType values, updated in place
+    ///   - potential: `gridSize` floats
+    ///   - parameters: Grid and physical parameters
+    ///   - timeStep: Step size for the Visscher scheme (ignored by Euler)
+    ///   - steps: Number of steps
+    func encode(
+        into commandBuffer: MTLCommandBuffer, waveFunction: MTLBuffer, potential: MTLBuffer,
+        parameters: QuantumKernelParameters, timeStep: Float, steps: Int
+    ) {
+        guard steps > 0, let encoder = commandBuffer.makeComputeCommandEncoder() else { return }
+
+        var params = parameters
+        encoder.setBuffer(waveFunction, offset: 0, index: 0)
+        encoder.setBuffer(potential, offset: 0, index: 1)
+        encoder.setBytes(&params, length: MemoryLayout<QuantumKernelParameters>.stride, index: 2)
+
+        let gridSize = MTLSize(width: Int(parameters.gridSize), height: 1, depth: 1)
+
+        func dispatch(_ pipeline: MTLComputePipelineState) {
+            encoder.setComputePipelineState(pipeline)
+            let threadGroupSize = MTLSize(
+                width: min(Int(parameters.gridSize), pipeline.maxTotalThreadsPerThreadgroup),
+                height: 1, depth: 1)
+            encoder.dispatchThreads(gridSize, threadsPerThreadgroup: threadGroupSize)
+        }
+
+        switch scheme {
+        case .euler:
+            if let pipeline = eulerPipeline {
+                for _ in 0..<steps {
+                    dispatch(pipeline)
+                }
+            }
+
+        case .visscher:
+            guard let real = realPipeline, let imag = imagPipeline else { break }
+
+            // Same stagger as the CPU engine: half step of Im to open, half step to close.
+            // Dispatches within one encoder execute in order, so each half update sees the last.
+            var halfStep = timeStep / 2
+            var fullStep = timeStep
+            encoder.setBytes(&halfStep, length: MemoryLayout<Float>.stride, index: 3)
+            dispatch(imag)
+
+            for step in 0..<steps {
+                encoder.setBytes(&fullStep, length: MemoryLayout<Float>.stride, index: 3)
+                dispatch(real)
+                if step == steps - 1 {
+                    encoder.setBytes(&halfStep, length: MemoryLayout<Float>.stride, index: 3)
+                }
+                dispatch(imag)
+            }
+        }
+
+        encoder.endEncoding()
+    }
+}
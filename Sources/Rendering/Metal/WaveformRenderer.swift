@@ -32,16 +32,32 @@ public class WaveformRenderer: NSObject, MTKViewDelegate {
         didSet {
             // Update shader settings when mode changes
             updateShaderSettings()
+            scheduler.invalidate()
         }
     }
 
     /// Visualization parameters
-    public var is3DMode: Bool = false
-    public var colorScheme: UInt32 = 0
-    public var showGrid: Bool = true
-    public var frequency: Double = 440.0
-    public var amplitude: Double = 0.5
-    public var waveType: Int = 0
+    public var is3DMode: Bool = false {
+        didSet { scheduler.invalidate() }
+    }
+    public var colorScheme: UInt32 = 0 {
+        didSet { scheduler.invalidate() }
+    }
+    public var showGrid: Bool = true {
+        didSet { scheduler.invalidate() }
+    }
+    public var frequency: Double = 440.0 {
+        didSet { scheduler.invalidate() }
+    }
+    public var amplitude: Double = 0.5 {
+        didSet { scheduler.invalidate() }
+    }
+    public var waveType: Int = 0 {
+        didSet { scheduler.invalidate() }
+    }
+
+    /// Pauses the view while nothing visible changes
+    let scheduler = RenderScheduler()
 
     // MARK: - Private Properties
 
@@ -60,6 +76,11 @@ public class WaveformRenderer: NSObject, MTKViewDelegate {
     private var waveformData: [Float] = []
     private var spectrumData: [Float] = []
     private var quantumData: [Float] = []
+    private var quantumVertexCount = 0
+
+    // Shared snapshot behind the quantum buffers when fed with `updateQuantumData(_:component:)`
+    private var quantumFrame: QuantumFrame?
+    private var quantumComponent: QuantumFrame.Component = .density
 
     // Rendering properties
     private var viewportSize = vector_float2(0, 0)
@@ -94,20 +115,52 @@ public class WaveformRenderer: NSObject, MTKViewDelegate {
 
     /// Update waveform data for rendering
     public func updateWaveformData(_ data: [Float]) {
+        guard data != waveformData else { return }
         waveformData = data
         updateWaveformBuffer()
+        scheduler.invalidate()
     }
 
     /// Update spectrum data for rendering
     public func updateSpectrumData(_ data: [Float]) {
+        guard data != spectrumData else { return }
         spectrumData = data
         updateSpectrumBuffer()
+        scheduler.invalidate()
     }
 
     /// Update quantum data for rendering
     public func updateQuantumData(_ data: [Float]) {
+        guard quantumFrame != nil || data != quantumData else { return }
+        quantumFrame = nil
         quantumData = data
         updateQuantumBuffer()
+        scheduler.invalidate()
+    }
+
+    /// Render one component of a shared quantum frame.
+    ///
+    /// The frame's page-aligned float storage is wrapped in place, so no copy is made. The
+    /// buffer's deallocator owns a reference to the frame, and Metal retains the buffer for every
+    /// command buffer that uses it, so the storage outlives in-flight frames even after the
+    /// renderer has moved on to a newer snapshot.
+    func updateQuantumData(_ frame: QuantumFrame, component: QuantumFrame.Component) {
+        guard frame !== quantumFrame || component != quantumComponent else { return }
+
+        let bytes = frame.floatBytes(component)
+        let buffer =
+            device.makeBuffer(
+                bytesNoCopy: bytes.pointer, length: bytes.length, options: .storageModeShared,
+                deallocator: { _, _ in withExtendedLifetime(frame) {} })
+            ?? device.makeBuffer(bytes: bytes.pointer, length: bytes.length, options: .storageModeShared)
+
+        quantumFrame = frame
+        quantumComponent = component
+        quantumData = []
+        quantumVertexCount = frame.count
+        quantum2DVertexBuffer = buffer
+        quantum3DVertexBuffer = buffer
+        scheduler.invalidate()
     }
 
     /// Set the viewport size
@@ -120,6 +173,7 @@ public class WaveformRenderer: NSObject, MTKViewDelegate {
         metalView = view
         view.device = device
         view.delegate = self
+        scheduler.attach(to: view)
     }
 
     // MARK: - MTKViewDelegate Methods
@@ -127,10 +181,12 @@ public class WaveformRenderer: NSObject, MTKViewDelegate {
     public func mtkView(_ view: MTKView, drawableSizeWillChange size: CGSize) {
         viewportSize = vector_float2(Float(size.width), Float(size.height))
         devicePixelRatio = Float(view.drawableSize.width / view.bounds.width)
+        scheduler.invalidate()
     }
 
     public func draw(in view: MTKView) {
-        guard let drawable = view.currentDrawable,
+        guard scheduler.beginFrame(),
+            let drawable = view.currentDrawable,
             let renderPassDescriptor = view.currentRenderPassDescriptor,
             let commandQueue = commandQueue
         else {
@@ -204,7 +260,7 @@ public class WaveformRenderer: NSObject, MTKViewDelegate {
                 renderEncoder.drawPrimitives(
                     type: .lineStrip,
                     vertexStart: 0,
-                    vertexCount: quantumData.count)
+                    vertexCount: quantumVertexCount)
             }
 
         case .quantum3D:
@@ -213,7 +269,7 @@ public class WaveformRenderer: NSObject, MTKViewDelegate {
                 renderEncoder.drawPrimitives(
                     type: .triangleStrip,
                     vertexStart: 0,
-                    vertexCount: quantumData.count * 2)
+                    vertexCount: quantumVertexCount * 2)
             }
         }
 
@@ -323,6 +379,7 @@ public class WaveformRenderer: NSObject, MTKViewDelegate {
     }
 
     private func updateQuantumBuffer() {
+        quantumVertexCount = quantumData.count
         let vertexBufferSize = MemoryLayout<Float>.size * quantumData.count
         quantum2DVertexBuffer = device.makeBuffer(
             bytes: quantumData,
@@ -1,3 +1,4 @@
+import Accelerate
 import Foundation
 import Metal
 import MetalKit
@@ -78,6 +79,10 @@ class WaveformRenderer3D: NSObject, MTKViewDelegate {
     private var waveFunctionBuffer: MTLBuffer
     private var meshVertexBuffer: MTLBuffer
     private var probabilityBuffer: MTLBuffer
+    private var probabilityCurrentBuffer: MTLBuffer
+    /// Fused |ψ|²/current pass encoded behind every wave-function dispatch; when it is
+    /// unavailable the density is computed on the CPU instead
+    private let densityKernel = ProbabilityCurrentKernel(detectorIndices: [])
 
     // MARK: - Camera and Transformation
 
@@ -106,6 +111,9 @@ class WaveformRenderer3D: NSObject, MTKViewDelegate {
     private var time: Float = 0.0
     private var animating: Bool = false
 
+    /// Pauses the view while nothing visible changes
+    let scheduler = RenderScheduler()
+
     // Add flag to prevent concurrent updates
     private var meshUpdateLockObj = ThreadSafe<Bool>(wrappedValue: false)
     private var isUpdatingMesh: Bool {
@@ -207,6 +215,15 @@ class WaveformRenderer3D: NSObject, MTKViewDelegate {
         }
         self.probabilityBuffer = probabilityBuffer
 
+        guard
+            let probabilityCurrentBuffer = device.makeBuffer(
+                length: gridSize * MemoryLayout<Float>.stride,
+                options: [.storageModeShared])
+        else {
+            fatalError("Failed to create probability current buffer")
+        }
+        self.probabilityCurrentBuffer = probabilityCurrentBuffer
+
         // Create a smaller buffer initially - we'll expand if needed later
         guard
             let meshVertexBuffer = device.makeBuffer(
@@ -322,33 +339,41 @@ class WaveformRenderer3D: NSObject, MTKViewDelegate {
 
         // Trigger mesh update
         createMesh()
+        scheduler.invalidate()
     }
 
     /// Sets the color scheme
     func setColorScheme(_ scheme: UInt32) {
         colorScheme = scheme
+        scheduler.invalidate()
     }
 
     /// Toggles wireframe mode
     func toggleWireframe(_ enabled: Bool) {
         showWireframe = enabled
+        scheduler.invalidate()
     }
 
     /// Toggles animation
     func setAnimating(_ animate: Bool) {
         animating = animate
+        if animate {
+            scheduler.invalidate()
+        }
     }
 
     /// Rotates the visualization by the given angle
     func rotate(byAngle angle: Float) {
         rotationAngle += angle
         updateViewMatrix()
+        scheduler.invalidate()
     }
 
     /// Resets the camera to default position
     func resetCamera() {
         rotationAngle = 0.0
         setupCamera()
+        scheduler.invalidate()
     }
 
     // MARK: - Private Methods
@@ -472,14 +497,14 @@ class WaveformRenderer3D: NSObject, MTKViewDelegate {
         // Dispatch the compute kernel
         computeEncoder.dispatchThreadgroups(gridSize, threadsPerThreadgroup: threadGroupSize)
         computeEncoder.endEncoding()
+        encodeDensityPass(into: commandBuffer)
 
         // Add completion handler to reset the updating flag and process results
         commandBuffer.addCompletedHandler { [weak self] _ in
             DispatchQueue.main.async {
                 guard let self = self else { return }
 
-                // Process results and update mesh
-                self.calculateProbabilityData()
+                // Process results and update mesh (the mesh reads the new density in place)
                 self.createMesh()
 
                 // Always reset the flag at the end
@@ -540,17 +565,38 @@ class WaveformRenderer3D: NSObject, MTKViewDelegate {
         // Dispatch the compute kernel
         encoder.dispatchThreadgroups(gridSize, threadsPerThreadgroup: threadGroupSize)
         encoder.endEncoding()
+        if let commandBuffer = commandBuffer {
+            encodeDensityPass(into: commandBuffer)
+        }
 
         // Don't wait - just commit and continue
         commandBuffer?.commit()
     }
 
+    /// Encode |ψ|² and the probability current into `probabilityBuffer` and
+    /// `probabilityCurrentBuffer`, reading the wave function the preceding dispatch wrote
+    private func encodeDensityPass(into commandBuffer: MTLCommandBuffer) {
+        guard let densityKernel = densityKernel else { return }
+
+        let domain = quantumParams.domain
+        let parameters = QuantumKernelParameters(
+            simulationTime: quantumParams.time, gridSize: UInt32(gridSize), domain: domain,
+            hbar: quantumParams.hbar, mass: quantumParams.mass)
+
+        // compute_quantum_wavefunction samples [domain.x, domain.y) at L/N
+        densityKernel.encode(
+            into: commandBuffer, waveFunction: waveFunctionBuffer, density: probabilityBuffer,
+            current: probabilityCurrentBuffer, parameters: parameters,
+            sampleSpacing: (domain.y - domain.x) / Float(gridSize), timeStep: 0)
+    }
+
     // MARK: - Mesh Creation Optimization
 
     // Reusable vertex array to avoid recreating arrays on each frame
     private var vertexCache: [Vertex] = []
     private var vertexCacheCapacity = 0
     private var lastMeshTime: Float = -1  // Track when mesh was last updated
+    private var lastProbabilityData: [Float] = []  // Density behind the current mesh
 
     private func createMesh() {
         // Skip recreation if already in progress
@@ -572,6 +618,17 @@ class WaveformRenderer3D: NSObject, MTKViewDelegate {
             return
         }
 
+        // A stationary density only advances the global phase; keep the mesh and let the view idle
+        if probabilityData.elementsEqual(lastProbabilityData) {
+            lastMeshTime = time
+            return
+        }
+        if lastProbabilityData.count == probabilityData.count {
+            lastProbabilityData.withUnsafeMutableBufferPointer { _ = $0.initialize(from: probabilityData) }
+        } else {
+            lastProbabilityData = Array(probabilityData)
+        }
+
         // Calculate required vertex count
         let requiredVertices = (gridSize - 1) * 6
 
@@ -609,6 +666,7 @@ class WaveformRenderer3D: NSObject, MTKViewDelegate {
 
         // Update the last mesh time
         lastMeshTime = time
+        scheduler.invalidate()
 
         // Handle any pending param updates
         if let pending = pendingParamUpdate {
@@ -625,7 +683,9 @@ class WaveformRenderer3D: NSObject, MTKViewDelegate {
     }
 
     // Modify generateMeshVertices to take the probability data as a parameter
-    private func generateMeshVertices(into vertices: inout [Vertex], with probabilityData: [Float])
+    private func generateMeshVertices(
+        into vertices: inout [Vertex], with probabilityData: UnsafeBufferPointer<Float>
+    )
     {
         // Scale for visualization
         let xScale: Float = 2.0 / Float(gridSize - 1)
@@ -725,6 +785,7 @@ class WaveformRenderer3D: NSObject, MTKViewDelegate {
         projectionMatrix = matrix_perspective_right_hand(fov, aspect, near, far)
         log("Updating view matrix")
         updateViewMatrix()
+        scheduler.invalidate()
         print("DEBUG: mtkView:drawableSizeWillChange: - Complete")
     }
 
@@ -734,7 +795,9 @@ class WaveformRenderer3D: NSObject, MTKViewDelegate {
             print("DEBUG: draw(in:)")
         #endif
 
-        guard let drawable = view.currentDrawable,
+        // Nothing changed for a while: skip the drawable and let the view stay paused
+        guard scheduler.beginFrame(),
+            let drawable = view.currentDrawable,
             let commandBuffer = commandQueue.makeCommandBuffer(),
             view.currentRenderPassDescriptor != nil
         else {
@@ -818,55 +881,37 @@ class WaveformRenderer3D: NSObject, MTKViewDelegate {
         }
     }
 
-    /// Retrieves probability data from wave function buffer
-    private func getProbabilityData() -> [Float] {
-        var probData = [Float](repeating: 0.0, count: gridSize)
-
-        // Access wave function buffer directly instead of using conditional binding
-        let waveData = waveFunctionBuffer.contents().assumingMemoryBound(to: Complex.self)
-
-        // Calculate probability density (|ψ|²)
-        for i in 0..<gridSize {
-            let psi = waveData[i]
-            probData[i] = psi.real * psi.real + psi.imag * psi.imag
-        }
-
-        // Find maximum probability for normalization
-        if let maxProb = probData.max(), maxProb > 0 {
-            for i in 0..<gridSize {
-                probData[i] /= maxProb
-            }
-        }
-
-        return probData
+    /// Retrieves probability data from wave function buffer.
+    ///
+    /// The density is written into `probabilityBuffer` and returned as a view of it, so the mesh
+    /// reads the same shared storage instead of a fresh array every frame.
+    private func getProbabilityData() -> UnsafeBufferPointer<Float> {
+        calculateProbabilityData()
+        return UnsafeBufferPointer(
+            start: probabilityBuffer.contents().assumingMemoryBound(to: Float.self), count: gridSize)
     }
 
     private func calculateProbabilityData() {
-        // Access wave function buffer directly
-        let waveData = waveFunctionBuffer.contents().bindMemory(
-            to: Complex.self, capacity: gridSize)
         let probDestination = probabilityBuffer.contents().bindMemory(
             to: Float.self, capacity: gridSize)
-
-        // Calculate probability density (|ψ|²) for each point
-        var maxProb: Float = 0.0
-
-        for i in 0..<gridSize {
-            let psi = waveData[i]
-            let probability = psi.real * psi.real + psi.imag * psi.imag
-            probDestination[i] = probability
-
-            // Track maximum for normalization
-            if probability > maxProb {
-                maxProb = probability
+        let length = vDSP_Length(gridSize)
+
+        // The GPU pass already wrote |ψ|² next to the wave function; otherwise compute it here,
+        // reading the interleaved pairs in place
+        if densityKernel == nil {
+            let waveData = waveFunctionBuffer.contents().bindMemory(
+                to: Complex.self, capacity: gridSize)
+            waveData.withMemoryRebound(to: Float.self, capacity: 2 * gridSize) { pairs in
+                var split = DSPSplitComplex(realp: pairs, imagp: pairs + 1)
+                vDSP_zvmags(&split, 2, probDestination, 1, length)
             }
         }
 
         // Normalize probabilities if we found a non-zero maximum
+        var maxProb: Float = 0.0
+        vDSP_maxv(probDestination, 1, &maxProb, length)
         if maxProb > 0 {
-            for i in 0..<gridSize {
-                probDestination[i] /= maxProb
-            }
+            vDSP_vsdiv(probDestination, 1, &maxProb, probDestination, 1, length)
         }
 
         log("Probability data calculated with max value: \(maxProb)")
@@ -137,13 +137,53 @@ kernel void quantum_time_evolution(
     waveFunction[id] = psi;
 }
 
-// Compute probability density from wave function
-kernel void compute_probability_density(device const ComplexType *waveFunction [[buffer(0)]],
+// Fused |ψ|² and probability current j = (ℏ/m) Im(ψ* ∂ψ/∂x) (periodic central differences).
+// The sample spacing comes from the caller: the renderers sample [domain.x, domain.y) at L/N,
+// while simulator grids include both ends at L/(N−1). Detector fluxes ∫ j dt are accumulated
+// in the same pass: each detector cell is owned by exactly one thread, so the update needs no
+// atomics. Like FluxDetectors on the CPU, detector currents use the spectral derivative
+// ψ'(x_i) = Σ_m w_m ψ_{i−m} rather than the display stencil, which reads k low by sin(k dx)/(k dx).
+kernel void compute_probability_density_current(device const ComplexType *waveFunction [[buffer(0)]],
                               device float *probDensity [[buffer(1)]],
-                              constant QuantumParameters &params [[buffer(2)]],
+                              device float *probCurrent [[buffer(2)]],
+                              constant QuantumParameters &params [[buffer(3)]],
+                              device const uint *detectorIndices [[buffer(4)]],
+                              device float *detectorFlux [[buffer(5)]],
+                              constant uint &detectorCount [[buffer(6)]],
+                              constant float &dt [[buffer(7)]],
+                              constant float &dx [[buffer(8)]],
+                              device const float *derivativeWeights [[buffer(9)]],
                               uint id [[thread_position_in_grid]]) {
     if (id >= params.gridSize) return;
-    
+
+    uint left = (id > 0) ? id - 1 : params.gridSize - 1;
+    uint right = (id < params.gridSize - 1) ? id + 1 : 0;
+
     ComplexType psi = waveFunction[id];
+    ComplexType dpsi = complex_sub(waveFunction[right], waveFunction[left]);
+
+    float current = params.hbar / params.mass * (psi.real * dpsi.imag - psi.imag * dpsi.real) / (2.0 * dx);
     probDensity[id] = psi.real * psi.real + psi.imag * psi.imag; // |ψ|²
-} 
\ No newline at end of file
+    probCurrent[id] = current;
+
+    bool isDetector = false;
+    for (uint k = 0; k < detectorCount; k++) {
+        isDetector = isDetector || detectorIndices[k] == id;
+    }
+    if (!isDetector) return;
+
+    float slopeReal = 0.0;
+    float slopeImag = 0.0;
+    for (uint m = 1; m < params.gridSize; m++) {
+        ComplexType neighbour = waveFunction[id >= m ? id - m : id + params.gridSize - m];
+        slopeReal += derivativeWeights[m] * neighbour.real;
+        slopeImag += derivativeWeights[m] * neighbour.imag;
+    }
+    float detectorCurrent = params.hbar / params.mass * (psi.real * slopeImag - psi.imag * slopeReal);
+
+    for (uint k = 0; k < detectorCount; k++) {
+        if (detectorIndices[k] == id) {
+            detectorFlux[k] += detectorCurrent * dt;
+        }
+    }
+}
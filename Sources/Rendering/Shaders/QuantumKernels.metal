@@ -6,6 +6,12 @@ using namespace metal;
 #import "ShaderUtils.h"
 #import "ComplexUtils.h"
 
+// -ℏ²/(2m dx²), the coupling of the three-point Laplacian. In SI units ℏ² (~1e-68) is far below
+// the float range, so the factors are grouped to keep every intermediate near 1e-4…1e17.
+inline float kinetic_coupling(float hbar, float mass, float dx) {
+    return -0.5 * (hbar / mass) / (dx * dx) * hbar;
+}
+
 // Compute kernel for quantum state evolution
 kernel void quantum_evolution(device ComplexType *waveFunction [[buffer(0)]],
                             device const float *potential [[buffer(1)]],
@@ -25,18 +31,14 @@ kernel void quantum_evolution(device ComplexType *waveFunction [[buffer(0)]],
     ComplexType psi_right = waveFunction[right];
     
     float dx = (params.domain.y - params.domain.x) / float(params.gridSize);
-    float dx2 = dx * dx;
     
     // Kinetic energy term: -ℏ²/2m ∇²ψ
     ComplexType d2psi = complex_add(
         complex_sub(psi_left, complex_mul_scalar(psi, 2.0)),
         psi_right
     );
-    d2psi = complex_mul_scalar(d2psi, 1.0 / dx2);
     
-    ComplexType kinetic = complex_mul_scalar(d2psi, 
-        -0.5 * params.hbar * params.hbar / params.mass
-    );
+    ComplexType kinetic = complex_mul_scalar(d2psi, kinetic_coupling(params.hbar, params.mass, dx));
     
     // Potential energy term: Vψ
     ComplexType potential_term = complex_mul_scalar(psi, V);
@@ -51,6 +53,50 @@ kernel void quantum_evolution(device ComplexType *waveFunction [[buffer(0)]],
     waveFunction[id] = complex_add(psi, dPsi);
 }
 
+// Visscher staggered leapfrog: Re(ψ) lives at integer and Im(ψ) at half-integer time levels.
+// Because H is real, each half update reads only the other component, so both run in place
+// on the interleaved buffer with one Hamiltonian application each and no extra storage.
+// Stable for dt ≤ 2ℏ / (2ℏ²/(m dx²) + max|V|); the time step is passed in buffer(3).
+
+// H applied to one real component (periodic three-point Laplacian)
+inline float hamiltonian_component(float left, float center, float right, float V,
+                                   constant QuantumParameters &params) {
+    float dx = (params.domain.y - params.domain.x) / float(params.gridSize);
+    return kinetic_coupling(params.hbar, params.mass, dx) * (left - 2.0 * center + right) + V * center;
+}
+
+// Re(ψ) ← Re(ψ) + (dt/ℏ) H Im(ψ)
+kernel void quantum_evolution_visscher_real(device ComplexType *waveFunction [[buffer(0)]],
+                                            device const float *potential [[buffer(1)]],
+                                            constant QuantumParameters &params [[buffer(2)]],
+                                            constant float &dt [[buffer(3)]],
+                                            uint id [[thread_position_in_grid]]) {
+    if (id >= params.gridSize) return;
+
+    uint left = (id > 0) ? id - 1 : params.gridSize - 1;
+    uint right = (id < params.gridSize - 1) ? id + 1 : 0;
+
+    float hImag = hamiltonian_component(waveFunction[left].imag, waveFunction[id].imag,
+                                        waveFunction[right].imag, potential[id], params);
+    waveFunction[id].real += dt / params.hbar * hImag;
+}
+
+// Im(ψ) ← Im(ψ) - (dt/ℏ) H Re(ψ)
+kernel void quantum_evolution_visscher_imag(device ComplexType *waveFunction [[buffer(0)]],
+                                            device const float *potential [[buffer(1)]],
+                                            constant QuantumParameters &params [[buffer(2)]],
+                                            constant float &dt [[buffer(3)]],
+                                            uint id [[thread_position_in_grid]]) {
+    if (id >= params.gridSize) return;
+
+    uint left = (id > 0) ? id - 1 : params.gridSize - 1;
+    uint right = (id < params.gridSize - 1) ? id + 1 : 0;
+
+    float hReal = hamiltonian_component(waveFunction[left].real, waveFunction[id].real,
+                                        waveFunction[right].real, potential[id], params);
+    waveFunction[id].imag -= dt / params.hbar * hReal;
+}
+
 // Calculate probability density
 kernel void probability_density(device const ComplexType *waveFunction [[buffer(0)]],
                              device float *probDensity [[buffer(1)]],
@@ -82,17 +128,14 @@ kernel void energy_calculation(device const ComplexType *waveFunction [[buffer(0
     ComplexType psi_right = waveFunction[right];
     
     float dx = (params.domain.y - params.domain.x) / float(params.gridSize);
-    float dx2 = dx * dx;
     
     // Kinetic energy: -ℏ²/2m ∇²ψ
     ComplexType d2psi = complex_add(
         complex_sub(psi_left, complex_mul_scalar(psi, 2.0)),
         psi_right
     );
-    d2psi = complex_mul_scalar(d2psi, 1.0 / dx2);
     
-    float kineticEnergy = -0.5 * params.hbar * params.hbar * 
-        complex_dot(d2psi, psi) / params.mass;
+    float kineticEnergy = kinetic_coupling(params.hbar, params.mass, dx) * complex_dot(d2psi, psi);
     
     float potentialEnergy = V * complex_abs2(psi);
     
@@ -92,6 +92,14 @@ class PerformanceMonitor {
     private var lastFrameTime: CFAbsoluteTime = 0
     private var frameCount: UInt = 0
 
+    /// Render loops currently drawing continuously (see `RenderScheduler`)
+    private(set) var activeRenderLoops = 0
+
+    /// Whether every render loop has dropped to on-demand drawing
+    var isRenderingIdle: Bool {
+        return activeRenderLoops == 0
+    }
+
     // MARK: - Initialization
 
     private init() {
@@ -163,6 +171,21 @@ class PerformanceMonitor {
         }
     }
 
+    /// A render loop resumed continuous drawing
+    func renderLoopDidResume() {
+        activeRenderLoops += 1
+    }
+
+    /// A render loop paused because its output stopped changing
+    func renderLoopDidIdle() {
+        activeRenderLoops = max(0, activeRenderLoops - 1)
+        if activeRenderLoops == 0 {
+            currentMetrics.frameRate = 0
+            frameCount = 0
+            frameStartTime = CFAbsoluteTimeGetCurrent()
+        }
+    }
+
     /// Record the start of a quantum computation
     func startQuantumComputation() -> UInt64 {
         return mach_absolute_time()
@@ -272,6 +295,8 @@ class PerformanceMonitor {
             report += " | Audio: \(String(format: "%.1f ms", metrics.audioLatency * 1000))"
         }
 
+        report += " | \(ThreadConfiguration.shared.status.description)"
+
         return report
     }
 
@@ -406,25 +431,25 @@ class PerformanceMonitor {
                     }
                 } catch {
                     // Fallback to estimation based on frameRate
-                    let maxFrameRate: Double = 60.0  // Assumed maximum frame rate
-                    let gpuLoad = min(
-                        1.0, (1.0 / max(0.01, currentMetrics.frameRate)) * maxFrameRate)
-                    currentMetrics.gpuUsage = gpuLoad * 100.0
+                    currentMetrics.gpuUsage = estimatedGPUUsage()
                 }
             } else {
                 // Fallback to estimation based on frameRate
-                let maxFrameRate: Double = 60.0  // Assumed maximum frame rate
-                let gpuLoad = min(1.0, (1.0 / max(0.01, currentMetrics.frameRate)) * maxFrameRate)
-                currentMetrics.gpuUsage = gpuLoad * 100.0
+                currentMetrics.gpuUsage = estimatedGPUUsage()
             }
         #else
             // Simple estimation for iOS
-            let maxFrameRate: Double = 60.0  // Assumed maximum frame rate
-            let gpuLoad = min(1.0, (1.0 / max(0.01, currentMetrics.frameRate)) * maxFrameRate)
-            currentMetrics.gpuUsage = gpuLoad * 100.0
+            currentMetrics.gpuUsage = estimatedGPUUsage()
         #endif
     }
 
+    /// GPU load estimated from the frame rate; zero while every render loop is idle
+    private func estimatedGPUUsage() -> Double {
+        guard !isRenderingIdle else { return 0 }
+        let maxFrameRate: Double = 60.0  // Assumed maximum frame rate
+        return min(1.0, currentMetrics.frameRate / maxFrameRate) * 100.0
+    }
+
     /// Determine energy impact based on various metrics
     private func updateEnergyImpact() {
         let cpuThreshold: Double = 75.0
@@ -0,0 +1,82 @@
+import Foundation
+import MetalKit
+
+/// Switches an `MTKView` between continuous and on-demand drawing.
+///
+/// Renderers call `invalidate()` whenever something that feeds the picture changes (data,
+/// parameters, camera, drawable size) and ask `beginFrame()` at the top of `draw(in:)`.
+/// After `idleFrameThreshold` consecutive frames without a change the view is paused and
+/// further draw requests are skipped until the next change, which un-pauses it at once.
+/// Cosmetic shader effects driven only by wall-clock time do not count as changes, so a
+/// stationary picture costs no frames at all.
+final class RenderScheduler {
+    /// Unchanged frames drawn before the view drops to on-demand drawing
+    var idleFrameThreshold = 30
+
+    /// Whether the view is currently paused for lack of changes
+    private(set) var isIdle = true
+
+    private weak var view: MTKView?
+    private var pendingChange = true
+    private var unchangedFrames = 0
+
+    deinit {
+        if !isIdle {
+            PerformanceMonitor.shared.renderLoopDidIdle()
+        }
+    }
+
+    /// Take over the draw loop of `view`, starting with continuous drawing
+    func attach(to view: MTKView) {
+        self.view = view
+        view.enableSetNeedsDisplay = true
+        invalidate()
+    }
+
+    /// Something visible changed: draw it and keep drawing continuously
+    func invalidate() {
+        onMain {
+            self.pendingChange = true
+            self.unchangedFrames = 0
+
+            if self.isIdle {
+                self.isIdle = false
+                PerformanceMonitor.shared.renderLoopDidResume()
+            }
+            self.view?.isPaused = false
+            self.view?.needsDisplay = true
+        }
+    }
+
+    /// Call at the start of `draw(in:)`
+    /// - Returns: Whether the frame should be rendered
+    func beginFrame() -> Bool {
+        let changed = pendingChange
+        pendingChange = false
+
+        if changed {
+            unchangedFrames = 0
+        } else if !isIdle {
+            unchangedFrames += 1
+            if unchangedFrames >= idleFrameThreshold {
+                isIdle = true
+                view?.isPaused = true
+                PerformanceMonitor.shared.renderLoopDidIdle()
+            }
+        }
+
+        let render = changed || !isIdle
+        if render {
+            PerformanceMonitor.shared.frameRendered()
+        }
+        return render
+    }
+
+    private func onMain(_ body: @escaping () -> Void) {
+        if Thread.isMainThread {
+            body()
+        } else {
+            DispatchQueue.main.async(execute: body)
+        }
+    }
+}
@@ -121,6 +121,10 @@ class WaveformViewModel: ObservableObject {
     @Published var quantumAudioScalingFactor: Double = 1e34  // Scaling between quantum and audio domains
     @Published var scientificNotation: Bool = true  // Display values in scientific notation
     @Published var quantumObservables: [String: Double] = [:]  // Observable values for quantum system
+    @Published var transitionRabiMap: RabiMap?  // Driven population of the last transition
+
+    // Parameter-driven recomputations; a newer request for the same target supersedes older ones
+    private let computations = SupersedingJobQueue()
 
     // MARK: - Performance & Animation Properties
 
@@ -217,8 +221,11 @@ class WaveformViewModel: ObservableObject {
         // Set up initial values
         quantumSimulator.setEnergyLevel(energyLevel)
 
-        // Update simulation
-        updateQuantumSimulation()
+        // The first state is computed here rather than on the workers, so the views start
+        // from a complete model
+        if let result = makeQuantumSimulationJob()(CancellationToken()) {
+            applyQuantumSimulationResult(result)
+        }
 
         print("DEBUG: Bindings setup complete")
 
@@ -231,6 +238,7 @@ class WaveformViewModel: ObservableObject {
     deinit {
         stopPlayback()
         animationTimer?.invalidate()
+        computations.cancelAll()
         print("WaveformViewModel deallocated properly")
     }
 
@@ -278,30 +286,99 @@ class WaveformViewModel: ObservableObject {
         }
     }
 
-    /// Updates the quantum simulation with current parameters
+    /// Updates the quantum simulation with current parameters.
+    ///
+    /// The simulation and everything derived from it are recomputed on the simulation workers
+    /// against a copy of the simulator. When the job finishes, the copy replaces `quantumSimulator`
+    /// on the main queue, the observables are published together and the visualization is
+    /// refreshed; until then the previous state stays visible. Slider drags request an update for
+    /// every intermediate value, and each request cancels the one before it, so only the last
+    /// value is simulated to the end.
     func updateQuantumSimulation() {
-        // Skip debug log message that was here before
-
-        // Configure simulator with current parameters
-        quantumSimulator.setSystemType(quantumSystemType)
-        quantumSimulator.setEnergyLevel(energyLevel)
-        quantumSimulator.setParticleMass(particleMass)
-        quantumSimulator.setPotentialHeight(potentialHeight)
-        quantumSimulator.setAnimateTimeEvolution(animateTimeEvolution)
+        computations.submit(target: "quantumSimulation", work: makeQuantumSimulationJob()) { [weak self] result in
+            guard let result = result else { return }
+            self?.applyQuantumSimulationResult(result)
+        }
+    }
 
-        // Run simulation
-        quantumSimulator.runSimulation()
+    /// Simulator and derived values from one recompute, published together
+    private struct QuantumSimulationResult {
+        let simulator: QuantumSimulator
+        let deBroglieWavelength: Double
+        let quantumEnergy: Double
+        let uncertaintyProduct: Double
+        let expectedPosition: Double
+        let observables: [String: Double]
+    }
 
-        // Update domain bridge calculations
-        updateDomainBridgeCalculations()
+    /// Snapshot the current parameters into a recompute that touches only its own simulator copy
+    /// - Returns: The job; it returns nil when cancelled between stages
+    private func makeQuantumSimulationJob() -> (CancellationToken) -> QuantumSimulationResult? {
+        // Configure a copy with current parameters
+        let simulator = quantumSimulator.copy()
+        simulator.setSystemType(quantumSystemType)
+        simulator.setEnergyLevel(energyLevel)
+        simulator.setParticleMass(particleMass)
+        simulator.setPotentialHeight(potentialHeight)
+        simulator.setAnimateTimeEvolution(animateTimeEvolution)
+
+        // Keep any time-dependent drive in step with the audio frequency
+        simulator.setDrivingFrequency(2 * Double.pi * mapAudibleFrequencyToQuantum(frequency))
+
+        let systemType = quantumSystemType
+        let level = energyLevel
+        let mass = particleMass
+        let hBar = reducedPlanckConstant
+
+        return { token in
+            // Run simulation
+            simulator.runSimulation()
+            guard !token.isCancelled else { return nil }
+
+            // Domain bridge calculations
+            let deBroglieWavelength = simulator.calculateDeBroglieWavelength()
+            let quantumEnergy = simulator.getExpectedEnergy()
+            let uncertaintyProduct = hBar / 2.0
+            let expectedPosition = WaveformViewModel.expectedPosition(
+                grid: simulator.getSpatialGrid(), density: simulator.getProbabilityDensityGrid())
+            guard !token.isCancelled else { return nil }
+
+            // Quantum observables
+            var observables = WaveformViewModel.systemObservables(
+                of: simulator, systemType: systemType, level: level, mass: mass, hBar: hBar,
+                energy: quantumEnergy, deBroglieWavelength: deBroglieWavelength)
+            observables["expected_position"] = expectedPosition
+            observables["uncertainty_relation"] = uncertaintyProduct
+
+            return QuantumSimulationResult(
+                simulator: simulator, deBroglieWavelength: deBroglieWavelength, quantumEnergy: quantumEnergy,
+                uncertaintyProduct: uncertaintyProduct, expectedPosition: expectedPosition, observables: observables)
+        }
+    }
 
-        // Update quantum observables
-        updateQuantumObservables()
+    /// Publish a finished recompute; runs on the main queue
+    private func applyQuantumSimulationResult(_ result: QuantumSimulationResult) {
+        // The animation clock kept running on the old simulator while the copy was computed
+        result.simulator.adoptClock(of: quantumSimulator)
+        quantumSimulator = result.simulator
+
+        deBroglieWavelength = result.deBroglieWavelength
+        quantumEnergy = result.quantumEnergy
+        uncertaintyProduct = result.uncertaintyProduct
+        expectedPosition = result.expectedPosition
+
+        // The transition map's entries come from their own job and stay until it is replaced
+        var observables = result.observables
+        for (key, value) in quantumObservables where key.hasPrefix("transition_") {
+            observables[key] = value
+        }
+        quantumObservables = observables
 
-        // Update visualization if needed
+        // Update visualization if needed; the data is new even if a frame was just drawn
         if visualizationType == .probability || visualizationType == .realPart
             || visualizationType == .imaginaryPart || visualizationType == .phase
         {
+            lastVisualizationUpdateTime = 0
             updateVisualization()
         }
     }
@@ -360,19 +437,14 @@ class WaveformViewModel: ObservableObject {
                 renderer.updateSpectrumData(spectrumData.map { Float($0) })
 
             case .probability:
-                let probData = quantumSimulator.getProbabilityDensityGrid()
-                // Use updateQuantumData instead since there's no updateProbabilityData method
-                renderer.updateQuantumData(probData.map { Float($0) })
+                // The renderer wraps the shared frame's float storage; nothing is copied
+                renderer.updateQuantumData(quantumSimulator.currentFrame(), component: .density)
 
             case .realPart:
-                let waveFunc = quantumSimulator.getWaveFunctionComponents()
-                // Use updateQuantumData since there's no updateWaveFunctionData method
-                renderer.updateQuantumData(waveFunc.real.map { Float($0) })
+                renderer.updateQuantumData(quantumSimulator.currentFrame(), component: .real)
 
             case .imaginaryPart:
-                let waveFunc = quantumSimulator.getWaveFunctionComponents()
-                // Use updateQuantumData since there's no updateWaveFunctionData method
-                renderer.updateQuantumData(waveFunc.imaginary.map { Float($0) })
+                renderer.updateQuantumData(quantumSimulator.currentFrame(), component: .imaginary)
 
             case .phase:
                 let phaseData = quantumSimulator.getPhaseGrid()
@@ -583,11 +655,48 @@ class WaveformViewModel: ObservableObject {
         energyLevel = toLevel
         energyLevelFloat = Double(toLevel)
 
+        updateTransitionDynamics(fromLevel: fromLevel, toLevel: toLevel)
+
         // Update
         updateWaveform()
         updateQuantumSimulation()
     }
 
+    /// Rabi map of the driven transition: target population over detuning and drive strength
+    /// after two resonant Rabi periods at the strongest drive
+    private func updateTransitionDynamics(fromLevel: Int, toLevel: Int) {
+        guard fromLevel != toLevel, fromLevel >= 1, toLevel >= 1 else { return }
+
+        let system = quantumSimulator.makeLevelSystem(levelCount: max(fromLevel, toLevel) + 1)
+        let transitionEnergy = abs(system.energies[toLevel - 1] - system.energies[fromLevel - 1])
+        guard transitionEnergy > 0 else {
+            computations.cancel(target: "transitionDynamics")
+            transitionRabiMap = nil
+            return
+        }
+
+        // Weak drive (Ω ≪ ω₀) keeps the rotating-wave picture valid
+        let maxRabi = 1e-3 * transitionEnergy / (planckConstant / (2 * Double.pi))
+        let detunings = (0..<64).map { -3 * maxRabi + 6 * maxRabi * Double($0) / 63 }
+        let rabiFrequencies = (1...64).map { maxRabi * Double($0) / 64 }
+
+        // Solve off the main thread; a newer transition cancels this map between lane groups
+        let solver = RabiMapSolver(system: system, initialLevel: fromLevel - 1, targetLevel: toLevel - 1)
+        computations.submit(
+            target: "transitionDynamics",
+            work: { token in
+                solver.solve(
+                    detunings: detunings, rabiFrequencies: rabiFrequencies,
+                    duration: 2 * RabiMapSolver.rabiPeriod(rabiFrequency: maxRabi), cancellation: token)
+            },
+            completion: { [weak self] map in
+                guard let self = self else { return }
+                self.transitionRabiMap = map
+                self.quantumObservables["transition_rabi_period"] = RabiMapSolver.rabiPeriod(rabiFrequency: maxRabi)
+                self.quantumObservables["transition_peak_population"] = map.populations.max() ?? 0
+            })
+    }
+
     /// Calculates and returns scientifically formatted quantum-audio relationship data
     func getQuantumAudioRelationship() -> [String: String] {
         var relationship: [String: String] = [:]
@@ -703,8 +812,11 @@ class WaveformViewModel: ObservableObject {
             visualizationType == .probability || visualizationType == .realPart
             || visualizationType == .imaginaryPart || visualizationType == .phase
 
+        // A stationary density looks the same at every time; skip it so the renderer can idle
+        let isStaticFrame = visualizationType == .probability && quantumSimulator.isStationary
+
         // Only perform updates if necessary
-        if needsQuantumUpdate {
+        if needsQuantumUpdate && !isStaticFrame {
             // Update quantum simulation with new time - update time manually first
             quantumSimulator.setTime(simulationTime)
             quantumSimulator.advanceTime()
@@ -801,22 +913,26 @@ class WaveformViewModel: ObservableObject {
         return pow(10, logAudible)
     }
 
-    /// Update the quantum-audio domain bridge calculations
-    private func updateDomainBridgeCalculations() {
-        // Calculate de Broglie wavelength
-        deBroglieWavelength = quantumSimulator.calculateDeBroglieWavelength()
+    /// Maps an audible frequency back to the quantum range (inverse of `mapQuantumFrequencyToAudible`)
+    private func mapAudibleFrequencyToQuantum(_ audioFreq: Double) -> Double {
+        let minQuantumFreq = 1e12  // 1 THz
+        let maxQuantumFreq = 1e18  // 1 EHz
 
-        // Calculate quantum energy
-        quantumEnergy = quantumSimulator.getExpectedEnergy()
+        let minAudibleFreq = 20.0  // 20 Hz
+        let maxAudibleFreq = 20000.0  // 20 kHz
 
-        // Calculate uncertainty relationship
-        let uncertainty = reducedPlanckConstant / 2.0
-        uncertaintyProduct = uncertainty
+        // Normalize the audible frequency on a log scale, then expand to the quantum range
+        let clamped = max(minAudibleFreq, min(maxAudibleFreq, audioFreq))
+        let normalizedLogAudible =
+            (log10(clamped) - log10(minAudibleFreq)) / (log10(maxAudibleFreq) - log10(minAudibleFreq))
+        let logQuantum =
+            log10(minQuantumFreq) + normalizedLogAudible * (log10(maxQuantumFreq) - log10(minQuantumFreq))
 
-        // Calculate expected position (simplified approximation)
-        let spatialGrid = quantumSimulator.getSpatialGrid()
-        let probDensity = quantumSimulator.getProbabilityDensityGrid()
+        return pow(10, logQuantum)
+    }
 
+    /// Expected position ⟨x⟩ from a sampled probability density
+    private static func expectedPosition(grid spatialGrid: [Double], density probDensity: [Double]) -> Double {
         // Calculate weighted average for position expectation value
         var sumPos = 0.0
         var sumWeight = 0.0
@@ -827,67 +943,54 @@ class WaveformViewModel: ObservableObject {
         }
 
         // Calculate position expectation value if weights are valid
-        if sumWeight > 0.0 {
-            expectedPosition = sumPos / sumWeight
-        } else {
-            expectedPosition = 0.0
-        }
-
-        // Note: Removed calculateRydbergStateEnergy call as this method doesn't exist
-        // A proper implementation would calculate the Rydberg energy using:
-        // E_n = -13.6 eV / n² (for hydrogen)
+        return sumWeight > 0.0 ? sumPos / sumWeight : 0.0
     }
 
-    /// Update observable quantum values for display
-    private func updateQuantumObservables() {
-        // Clear existing observables
-        quantumObservables.removeAll()
+    /// System-specific observable values for display
+    private static func systemObservables(
+        of simulator: QuantumSimulator, systemType: QuantumSystemType, level energyLevel: Int,
+        mass particleMass: Double, hBar: Double, energy quantumEnergy: Double, deBroglieWavelength: Double
+    ) -> [String: Double] {
+        var observables: [String: Double] = [:]
 
-        // Add system-specific observables
-        switch quantumSystemType {
+        switch systemType {
         case .freeParticle:
-            quantumObservables["de_broglie_wavelength"] = deBroglieWavelength
-            quantumObservables["momentum"] = reducedPlanckConstant / deBroglieWavelength
-            quantumObservables["kinetic_energy"] = quantumEnergy
+            observables["de_broglie_wavelength"] = deBroglieWavelength
+            observables["momentum"] = hBar / deBroglieWavelength
+            observables["kinetic_energy"] = quantumEnergy
 
         case .potentialWell:
             let width = 20e-9  // Approximate well width from simulation
-            quantumObservables["energy_level"] = Double(energyLevel)
-            quantumObservables["energy"] = quantumEnergy
-            quantumObservables["energy_ev"] = quantumEnergy / 1.602176634e-19
-            quantumObservables["confinement_width"] = width
+            observables["energy_level"] = Double(energyLevel)
+            observables["energy"] = quantumEnergy
+            observables["energy_ev"] = quantumEnergy / 1.602176634e-19
+            observables["confinement_width"] = width
 
         case .harmonicOscillator:
             // Approximate angular frequency from energy level difference
-            let originalLevel = energyLevel
-            let originalEnergy = quantumEnergy
+            simulator.setEnergyLevel(energyLevel + 1)
+            let nextLevelEnergy = simulator.getExpectedEnergy()
 
-            quantumSimulator.setEnergyLevel(originalLevel + 1)
-            let nextLevelEnergy = quantumSimulator.getExpectedEnergy()
-
-            let omegaApprox = (nextLevelEnergy - originalEnergy) / reducedPlanckConstant
+            let omegaApprox = (nextLevelEnergy - quantumEnergy) / hBar
 
             // Reset to original level
-            quantumSimulator.setEnergyLevel(originalLevel)
+            simulator.setEnergyLevel(energyLevel)
 
-            quantumObservables["energy_level"] = Double(energyLevel)
-            quantumObservables["energy"] = quantumEnergy
-            quantumObservables["angular_frequency"] = omegaApprox
-            quantumObservables["classical_amplitude"] = sqrt(
+            observables["energy_level"] = Double(energyLevel)
+            observables["energy"] = quantumEnergy
+            observables["angular_frequency"] = omegaApprox
+            observables["classical_amplitude"] = sqrt(
                 2 * quantumEnergy / (particleMass * omegaApprox * omegaApprox))
 
         case .hydrogenAtom:
-            let rydberg = 2.179e-18  // Rydberg energy in joules
-            quantumObservables["principal_quantum_number"] = Double(energyLevel)
-            quantumObservables["energy"] = quantumEnergy
-            quantumObservables["energy_ev"] = quantumEnergy / 1.602176634e-19
-            quantumObservables["orbital_radius"] =
+            observables["principal_quantum_number"] = Double(energyLevel)
+            observables["energy"] = quantumEnergy
+            observables["energy_ev"] = quantumEnergy / 1.602176634e-19
+            observables["orbital_radius"] =
                 5.29177210903e-11 * Double(energyLevel * energyLevel)  // Bohr radius * n²
         }
 
-        // Add common observables
-        quantumObservables["expected_position"] = expectedPosition
-        quantumObservables["uncertainty_relation"] = uncertaintyProduct
+        return observables
     }
 
     /// Format a value in scientific notation if needed
@@ -986,10 +1089,9 @@ class WaveformViewModel: ObservableObject {
         metalView.enableSetNeedsDisplay = true
         metalView.preferredFramesPerSecond = targetFrameRate
         metalView.autoResizeDrawable = true
-        metalView.isPaused = false
 
-        // Force an initial draw
-        metalView.needsDisplay = true
+        // Draw continuously while the picture changes, on demand once it settles
+        renderer.scheduler.attach(to: metalView)
 
         print("2D renderer connected to view")
     }
@@ -1016,10 +1118,9 @@ class WaveformViewModel: ObservableObject {
         // Configure for 3D rendering
         metalView.depthStencilPixelFormat = .depth32Float
         metalView.clearColor = MTLClearColor(red: 0.0, green: 0.0, blue: 0.2, alpha: 1.0)
-        metalView.enableSetNeedsDisplay = true
 
-        // Force an initial draw
-        metalView.needsDisplay = true
+        // Draw continuously while the picture changes, on demand once it settles
+        renderer.scheduler.attach(to: metalView)
 
         print("3D renderer successfully connected to MTKView")
     }
@@ -0,0 +1,1153 @@
+//
+//  QuantumPropagatorTests.swift
+//  QwantumWaveform
+//
+
+import XCTest
+@testable import QuantumWaveform
+
+final class QuantumPropagatorTests: XCTestCase {
+    // Test constants
+    private let electronMass = 9.1093837e-31 // kg
+
+    // Test instance
+    private var simulator: QuantumSimulator!
+
+    override func setUp() {
+        super.setUp()
+        simulator = QuantumSimulator()
+        simulator.setSystemType(.freeParticle)
+        simulator.setParticleMass(electronMass)
+    }
+
+    override func tearDown() {
+        simulator = nil
+        super.tearDown()
+    }
+
+    // MARK: - Tests
+
+    func testSplitOperatorConservesNorm() {
+        let propagator = simulator.makeSplitOperatorPropagator(pointCount: 256)
+        var state = simulator.makeInitialState(on: propagator.grid)
+        let initialNorm = state.norm(dx: propagator.grid.dx)
+
+        propagator.propagate(&state, timeStep: 1e-17, steps: 200)
+
+        XCTAssertEqual(initialNorm, 1.0, accuracy: 1e-9, "Initial state should be normalized")
+        XCTAssertEqual(state.norm(dx: propagator.grid.dx), initialNorm, accuracy: 1e-9,
+                       "Split-operator stepping should be unitary")
+    }
+
+    func testCancelledPropagationEndsOnACompleteStep() {
+        let cancelled = CancellationToken()
+        cancelled.cancel()
+
+        // A token cancelled up front stops the run after its first step, with the step closed
+        let propagator = simulator.makeSplitOperatorPropagator(pointCount: 256)
+        let initial = simulator.makeInitialState(on: propagator.grid)
+        var stopped = initial
+        var single = initial
+        propagator.propagate(&stopped, timeStep: 1e-17, steps: 200, cancellation: cancelled)
+        propagator.propagate(&single, timeStep: 1e-17, steps: 1)
+        XCTAssertEqual(zip(stopped.real, single.real).map { abs($0 - $1) }.max()!, 0, accuracy: 1e-12)
+        XCTAssertEqual(zip(stopped.imaginary, single.imaginary).map { abs($0 - $1) }.max()!, 0, accuracy: 1e-12)
+
+        let adi = simulator.makeADIPropagator(dimensions: 2, pointsPerAxis: 32)
+        let adiInitial = simulator.makeADIState(for: adi)
+        var adiStopped = adiInitial
+        var adiSingle = adiInitial
+        adi.propagate(&adiStopped, timeStep: 1e-16, steps: 200, cancellation: cancelled)
+        adi.propagate(&adiSingle, timeStep: 1e-16, steps: 1)
+        XCTAssertEqual(zip(adiStopped.real, adiSingle.real).map { abs($0 - $1) }.max()!, 0, accuracy: 1e-12)
+        XCTAssertEqual(adi.norm(of: adiStopped), adi.norm(of: adiInitial), accuracy: 1e-10)
+    }
+
+    func testPararealMatchesSerialFineSolution() {
+        let propagator = simulator.makeSplitOperatorPropagator(pointCount: 256)
+        let initialState = simulator.makeInitialState(on: propagator.grid)
+        let duration = 4e-15
+
+        var configuration = PararealIntegrator.Configuration()
+        configuration.sliceCount = 4
+        configuration.coarseStepsPerSlice = 2
+        configuration.fineStepsPerSlice = 50
+        configuration.maxIterations = 4
+        configuration.tolerance = 0
+
+        let integrator = PararealIntegrator(coarse: propagator, fine: propagator, configuration: configuration)
+        let result = integrator.integrate(initialState, duration: duration)
+
+        var serial = initialState
+        propagator.propagate(&serial, duration: duration, steps: 200)
+
+        // After sliceCount iterations Parareal reproduces the serial fine run exactly
+        XCTAssertTrue(result.converged, "Parareal should converge within sliceCount iterations")
+        XCTAssertLessThan(ComplexArray.distance(result.finalState, serial), 1e-6 * sqrt(serial.squaredMagnitudeSum),
+                          "Parareal should match the serial fine solution")
+    }
+
+    func testRadialPropagatorKeepsHydrogenGroundStateStationary() {
+        simulator.setSystemType(.hydrogenAtom)
+        simulator.setEnergyLevel(1)
+        let propagator = simulator.makeRadialPropagator(angularMomentum: 0, pointCount: 1024)
+        var state = simulator.makeRadialState(for: propagator)
+        let initialDensity = propagator.radialProbabilityDensity(state)
+
+        propagator.propagate(&state, timeStep: 1e-18, steps: 100)
+
+        // Crank–Nicolson is exactly unitary in the grid quadrature, and 1s is an eigenstate
+        let finalDensity = propagator.radialProbabilityDensity(state)
+        let peak = initialDensity.max() ?? 1
+        let drift = zip(initialDensity, finalDensity).map { abs($0 - $1) }.max() ?? 0
+        XCTAssertEqual(propagator.norm(of: state), 1.0, accuracy: 1e-10,
+                       "Radial Crank-Nicolson stepping should be unitary")
+        XCTAssertLessThan(drift, 1e-2 * peak, "The 1s density should stay stationary")
+    }
+
+    func testAxisymmetricOscillatorStatesStayStationaryAndFillTheVolume() {
+        // Isotropic trap: ψ ∝ r^|m| exp(−(r² + z²)/2ℓ²) is the lowest state of each m sector
+        let hBar = QuantumMath.reducedPlanckConstant
+        let length = 2e-9
+        let omega = hBar / (electronMass * length * length)
+        let axialGrid = QuantumGrid(xMin: -10e-9, xMax: 10e-9, count: 128)
+        let quarterPeriod = 0.25 * 2 * Double.pi / omega
+
+        func densityDrift(operatorM: Int, profileM: Int) -> Double {
+            let propagator = AxisymmetricPropagator(
+                radialCount: 96, maxRadius: 10e-9, axialGrid: axialGrid, azimuthalNumber: operatorM,
+                mass: electronMass) { r, z in 0.5 * self.electronMass * omega * omega * (r * r + z * z) }
+            var psi = propagator.makeState { r, z in
+                Complex(real: pow(r, Double(profileM)) * exp(-(r * r + z * z) / (2 * length * length)))
+            }
+            let initial = psi.probabilityDensity
+            XCTAssertEqual(propagator.norm(of: psi), 1, accuracy: 1e-12)
+
+            // The density volume integrates to the cylindrical norm
+            let resolution = 64
+            let spacing = 2 * propagator.maxRadius / Double(resolution - 1)
+            let volume = propagator.densityVolume(psi, resolution: resolution)
+            let volumeNorm = volume.reduce(0) { $0 + Double($1) } * spacing * spacing * axialGrid.dx
+            XCTAssertEqual(volumeNorm, 1, accuracy: 1e-2, "The Cartesian volume should hold the whole state")
+
+            // A quarter period is where a mismatched profile has moved furthest
+            propagator.propagate(&psi, timeStep: quarterPeriod / 200, steps: 200)
+            XCTAssertEqual(propagator.norm(of: psi), 1, accuracy: 1e-10,
+                           "Crank–Nicolson sweeps should conserve the cylindrical norm")
+
+            let final = psi.probabilityDensity
+            let peak = initial.max() ?? 1
+            return zip(initial, final).map { abs($0 - $1) }.max()! / peak
+        }
+
+        XCTAssertLessThan(densityDrift(operatorM: 0, profileM: 0), 1e-2, "The m = 0 ground state should stay put")
+        XCTAssertLessThan(densityDrift(operatorM: 1, profileM: 1), 1e-2, "The m = 1 ground state should stay put")
+        XCTAssertGreaterThan(densityDrift(operatorM: 1, profileM: 0), 0.5,
+                             "The centrifugal term should push an m = 0 profile off the axis")
+    }
+
+    func testBlochSolverReproducesFreeLatticeDispersion() {
+        let samples = 32
+        let latticeConstant = 1e-9
+        let solver = BlochBandSolver(
+            cellPotential: [Double](repeating: 0, count: samples), latticeConstant: latticeConstant,
+            mass: electronMass)
+        let bands = solver.solve(bandCount: 2, kPointCount: 513)
+
+        // With V = 0 the lowest band is the discrete free dispersion 2c(1 − cos k·dx)
+        let hBar = QuantumMath.reducedPlanckConstant
+        let coupling = hBar * hBar / (2 * electronMass * solver.dx * solver.dx)
+        for (index, k) in bands.waveNumbers.enumerated() {
+            let expected = 2 * coupling * (1 - cos(k * solver.dx))
+            XCTAssertEqual(bands.energies[0][index], expected, accuracy: 1e-6 * coupling,
+                           "Band 0 should follow the free dispersion")
+        }
+
+        // Band 1 is the same parabola folded back at the zone edge
+        let zoneEdge = Double.pi / latticeConstant
+        XCTAssertEqual(bands.energies[1][0], bands.energies[0][0], accuracy: 1e-6 * coupling,
+                       "Bands should touch at the zone edge for an empty lattice")
+        XCTAssertEqual(bands.energies[1][256], 2 * coupling * (1 - cos(2 * zoneEdge * solver.dx)),
+                       accuracy: 1e-6 * coupling, "Band 1 should start at the first reciprocal vector")
+    }
+
+    func testLindbladDephasingMatchesAnalyticCoherenceDecay() {
+        // A heavy particle makes the coherent part negligible, so ρ(x, x′) decays exactly as
+        // e^{−γt(x − x′)²/2ℓ²} and the coherence between two packets measures the dissipator alone
+        let grid = QuantumGrid(xMin: -10e-9, xMax: 10e-9, count: 256)
+        let rate = 1e13
+        let length = 1e-9
+        let unitary = SplitOperatorPropagator(
+            grid: grid, mass: 1e-20, potential: [Double](repeating: 0, count: grid.count))
+        let propagator = LindbladPropagator(unitary: unitary, channels: [.dephasing(rate: rate, length: length)])
+
+        let separation = 2e-9
+        var cat = ComplexArray(count: grid.count)
+        for (j, x) in grid.positions.enumerated() {
+            let left = (x + separation) / 0.5e-9
+            let right = (x - separation) / 0.5e-9
+            cat[j] = Complex(real: exp(-left * left / 2) + exp(-right * right / 2))
+        }
+        cat.normalize(dx: grid.dx)
+
+        let right = Int(((separation - grid.xMin) / grid.dx).rounded())
+        let left = Int(((-separation - grid.xMin) / grid.dx).rounded())
+        func coherence(_ rho: LowRankDensityMatrix) -> Double {
+            let value = zip(rho.factors, rho.weights).reduce(Complex()) { sum, term in
+                sum + term.1 * (term.0[right] * term.0[left].conjugate)
+            }
+            return value.magnitude
+        }
+
+        let duration = 2e-14
+        let distance = grid.position(at: right) - grid.position(at: left)
+        let expected = exp(-rate * duration * distance * distance / (2 * length * length))
+
+        var errors = [Double]()
+        var traceErrors = [Double]()
+        for steps in [20, 40] {
+            var rho = LowRankDensityMatrix(pureState: cat)
+            let initial = coherence(rho)
+            propagator.propagate(&rho, timeStep: duration / Double(steps), steps: steps)
+
+            errors.append(abs(coherence(rho) / initial / expected - 1))
+            traceErrors.append(abs(rho.trace - 1))
+            XCTAssertGreaterThan(rho.rank, 1, "Dephasing should mix the state")
+            XCTAssertLessThan(rho.purity, 0.9, "Dephasing should lower the purity")
+            XCTAssertLessThanOrEqual(rho.rank, propagator.maxRank, "Rank should be truncated")
+        }
+
+        // The dissipator is second order: halving dt cuts both errors about 4×
+        XCTAssertLessThan(errors[0], 1e-3, "Coherences should decay at the analytic dephasing rate")
+        XCTAssertEqual(errors[0] / errors[1], 4, accuracy: 0.5)
+        XCTAssertLessThan(traceErrors[0], 1e-3, "The trace should be preserved up to the step error")
+        XCTAssertEqual(traceErrors[0] / traceErrors[1], 4, accuracy: 0.5)
+    }
+
+    func testQuantumJumpEnsembleIsReproducibleAcrossWorkerCounts() {
+        var configuration = QuantumJumpEnsemble.Configuration()
+        configuration.trajectoryCount = 16
+        configuration.sampleInterval = 10
+
+        // Per-trajectory Philox streams make the result independent of scheduling
+        configuration.workerCount = 1
+        let serial = simulator.runQuantumJumpSimulation(
+            duration: 2e-16, steps: 20, pointCount: 128, dephasingRate: 1e15, configuration: configuration)
+        configuration.workerCount = 4
+        let parallel = simulator.runQuantumJumpSimulation(
+            duration: 2e-16, steps: 20, pointCount: 128, dephasingRate: 1e15, configuration: configuration)
+
+        XCTAssertEqual(serial.jumps.mean[0], parallel.jumps.mean[0], accuracy: 1e-12,
+                       "Jump counts should not depend on the worker count")
+        for (a, b) in zip(serial.statistics.last!.mean, parallel.statistics.last!.mean) {
+            XCTAssertEqual(a, b, accuracy: 1e-9 * max(abs(a), 1), "Ensemble means should not depend on the worker count")
+        }
+        XCTAssertEqual(serial.statistics.last!.count, 16, "Every trajectory should be sampled")
+    }
+
+    func testRabiMapMatchesTwoLevelFormula() {
+        let electronVolt = 1.602176634e-19
+        let solver = RabiMapSolver(
+            system: NLevelSystem(energies: [0, electronVolt]), initialLevel: 0, targetLevel: 1)
+        let detunings = (0..<21).map { Double($0 - 10) * 2e12 }
+        let rabiFrequencies = [5e12, 1e13]
+        let duration = 1e-12
+        let map = solver.solve(
+            detunings: detunings, rabiFrequencies: rabiFrequencies, duration: duration, sampleCount: 4)
+
+        // P(t) = Ω²/(Ω² + Δ²) sin²(√(Ω² + Δ²) t/2)
+        for s in 0..<4 {
+            for (r, rabi) in rabiFrequencies.enumerated() {
+                for (d, detuning) in detunings.enumerated() {
+                    let generalized = sqrt(rabi * rabi + detuning * detuning)
+                    let angle = generalized * map.sampleTimes[s] / 2
+                    let expected = rabi * rabi / (generalized * generalized) * sin(angle) * sin(angle)
+                    XCTAssertEqual(map.population(detuning: d, rabiFrequency: r, sample: s), expected, accuracy: 1e-4,
+                                   "Batched RK4 should reproduce generalized Rabi oscillations")
+                }
+            }
+        }
+    }
+
+    func testPlaneWaveCurrentAndDetectorFlux() {
+        let grid = QuantumGrid(xMin: 0, xMax: 1e-8, count: 256)
+        let k = 2 * Double.pi * 8 / (grid.xMax - grid.xMin)
+        let psi = ComplexArray(real: grid.positions.map { cos(k * $0) }, imaginary: grid.positions.map { sin(k * $0) })
+        let (density, current) = psi.densityAndCurrent(dx: grid.dx, mass: electronMass)
+
+        // Central differences give (ħ/m) sin(k dx)/dx for a unit plane wave
+        let expected = QuantumMath.reducedPlanckConstant / electronMass * sin(k * grid.dx) / grid.dx
+        for i in [0, 100, 255] {
+            XCTAssertEqual(density[i], 1, accuracy: 1e-12)
+            XCTAssertEqual(current[i], expected, accuracy: 1e-9 * expected, "Current should be uniform")
+        }
+
+        // Detectors take the spectral derivative, which is exact for the resolved wave number
+        let exact = QuantumMath.reducedPlanckConstant * k / electronMass
+        var detectors = FluxDetectors(positions: [2e-9, 7e-9], grid: grid, mass: electronMass)
+        for _ in 0..<10 {
+            detectors.accumulate(psi, timeStep: 1e-16)
+        }
+        XCTAssertEqual(detectors.elapsedTime, 1e-15, accuracy: 1e-27)
+        for flux in detectors.integratedFlux {
+            XCTAssertEqual(flux, exact * 1e-15, accuracy: 1e-9 * exact * 1e-15,
+                           "Detector flux should be the time integral of the local current")
+        }
+    }
+
+    func testPhaseFieldUnwrapsAcrossChunks() {
+        let grid = QuantumGrid(xMin: 0, xMax: 1e-8, count: 1000)
+        let k = 2 * Double.pi * 37.3 / (grid.xMax - grid.xMin)
+        let positions = grid.positions
+        let envelope = positions.map { exp(-pow(($0 - 5e-9) / 2e-9, 2)) }
+        let psi = ComplexArray(
+            real: zip(positions, envelope).map { $1 * cos(k * $0) },
+            imaginary: zip(positions, envelope).map { $1 * sin(k * $0) })
+
+        // Chunks that do not divide the grid exercise the boundary steps and the carry pass
+        let field = psi.phaseField(dx: grid.dx, chunkSize: 64)
+        for (i, x) in positions.enumerated() {
+            XCTAssertEqual(field.unwrapped[i], k * x, accuracy: 1e-9, "Unwrapped phase should be linear")
+            XCTAssertLessThanOrEqual(abs(field.wrapped[i]), Double.pi)
+        }
+        XCTAssertEqual(field.localWaveNumber[500], sin(k * grid.dx) / grid.dx, accuracy: 1e-4 * k,
+                       "Local wave number should follow the central-difference plane-wave value")
+    }
+
+    func testOptimalControlGradientMatchesFiniteDifferences() {
+        simulator.setSystemType(.potentialWell)
+        let groundEnergy = simulator.getExpectedEnergy()
+        let optimizer = simulator.makeOptimalControlOptimizer(
+            duration: 2 * Double.pi * QuantumMath.reducedPlanckConstant / groundEnergy, sliceCount: 40, pointCount: 64)
+        let initial = simulator.makeInitialState(on: optimizer.grid, level: 1)
+        let target = simulator.makeInitialState(on: optimizer.grid, level: 2)
+
+        let width = optimizer.grid.xMax - optimizer.grid.xMin
+        let fieldScale = 3 * groundEnergy / (1.602176634e-19 * width / 2)
+        let controls = (0..<optimizer.controlCount).map { fieldScale * sin(0.7 * Double($0)) }
+
+        // Two snapshots force recomputation; the gradient must not depend on the schedule
+        optimizer.configuration.snapshotCount = 2
+        let checkpointed = optimizer.gradient(controls: controls, from: initial, to: target)
+        optimizer.configuration.snapshotCount = optimizer.sliceCount
+        let stored = optimizer.gradient(controls: controls, from: initial, to: target)
+        XCTAssertEqual(checkpointed.fidelity, optimizer.fidelity(controls: controls, from: initial, to: target),
+                       accuracy: 1e-12)
+
+        let largest = stored.gradient.reduce(0) { max($0, abs($1)) }
+        for index in [0, 13, 39] {
+            XCTAssertEqual(checkpointed.gradient[index], stored.gradient[index], accuracy: 1e-10 * largest)
+
+            let h = 1e-4 * fieldScale
+            var plus = controls
+            var minus = controls
+            plus[index] += h
+            minus[index] -= h
+            let difference = (optimizer.fidelity(controls: plus, from: initial, to: target)
+                - optimizer.fidelity(controls: minus, from: initial, to: target)) / (2 * h)
+            XCTAssertEqual(checkpointed.gradient[index], difference, accuracy: 1e-4 * largest,
+                           "Adjoint gradient should match central differences")
+        }
+    }
+
+    func testEventTimesAreRefinedWithinSteps() {
+        let grid = QuantumGrid(xMin: 0, xMax: 1e-8, count: 1024)
+        let width = grid.xMax - grid.xMin
+        let k = 2 * Double.pi * 20 / width
+        let (start, sigma) = (0.3 * width, 0.03 * width)
+        var psi = ComplexArray(count: grid.count)
+        for (i, x) in grid.positions.enumerated() {
+            let envelope = exp(-pow((x - start) / (2 * sigma), 2))
+            psi[i] = Complex(real: envelope * cos(k * x), imaginary: envelope * sin(k * x))
+        }
+        psi.normalize(dx: grid.dx)
+
+        // ⟨x⟩ moves at exactly ħk/m under free split-operator evolution
+        let speed = QuantumMath.reducedPlanckConstant * k / electronMass
+        let propagator = SplitOperatorPropagator(
+            grid: grid, mass: electronMass, potential: [Double](repeating: 0, count: grid.count))
+        let integrator = EventDrivenIntegrator(propagator: propagator, mass: electronMass)
+        let passed = ObservableEvent(name: "passed", direction: .rising, action: .checkpoint) {
+            $0.meanPosition - 0.5 * width
+        }
+        let arrived = ObservableEvent(name: "arrived", direction: .rising, action: .stop) {
+            $0.meanPosition - 0.6 * width
+        }
+
+        let dt = 0.2 * width / speed / 7.3
+        let result = integrator.run(psi, timeStep: dt, maxSteps: 100, events: [arrived, passed])
+
+        XCTAssertTrue(result.stopped)
+        XCTAssertEqual(result.occurrences.map { $0.name }, ["passed", "arrived"],
+                       "Events should be reported in time order")
+        XCTAssertEqual(result.occurrences[0].observables.time, 0.2 * width / speed, accuracy: 1e-5 * dt)
+        XCTAssertEqual(result.finalObservables.time, 0.3 * width / speed, accuracy: 1e-5 * dt)
+        XCTAssertEqual(result.stepsTaken, Int((0.3 * width / speed / dt).rounded(.up)),
+                       "The run should stop in the step containing the event")
+        XCTAssertNotNil(result.occurrences[0].state, "Checkpoint events should keep their state")
+    }
+
+    func testQuantumFrameViewsShareOneSnapshot() {
+        let real = (0..<1000).map { sin(Double($0) * 0.01) }
+        let imaginary = (0..<1000).map { cos(Double($0) * 0.03) }
+        let frame = QuantumFrame(time: 0.5, real: real, imaginary: imaginary)
+
+        XCTAssertEqual(Array(frame.real), real)
+        XCTAssertEqual(Array(frame.imaginary), imaginary)
+        XCTAssertEqual(frame.density.reduce(0, +), 1, accuracy: 1e-12, "Density should have unit sum")
+
+        let pageSize = Int(getpagesize())
+        let bytes = frame.floatBytes(.density)
+        XCTAssertEqual(Int(bitPattern: bytes.pointer) % pageSize, 0, "Float views should start on a page")
+        XCTAssertEqual(bytes.length % pageSize, 0, "Float views should span whole pages")
+        XCTAssertEqual(frame.floats(.density).baseAddress, frame.floats(.density).baseAddress,
+                       "Float views should be converted once and reused")
+
+        let floats = frame.floats(.imaginary)
+        let pairs = frame.interleaved
+        for i in stride(from: 0, to: 1000, by: 97) {
+            XCTAssertEqual(Double(floats[i]), imaginary[i], accuracy: 1e-6)
+            XCTAssertEqual(pairs[i].real, real[i])
+            XCTAssertEqual(pairs[i].imag, imaginary[i])
+        }
+    }
+
+    func testNewerJobsSupersedeOlderOnes() {
+        let queue = DispatchQueue(label: "QuantumPropagatorTests.jobs")
+        let jobs = SupersedingJobQueue(queue: queue)
+        let delivered = expectation(description: "latest job delivered")
+        var ran = [Int]()
+
+        // Hold the queue so both requests are pending when the second arrives
+        queue.suspend()
+        let first = jobs.submit(target: "map", work: { _ -> Int in ran.append(1); return 1 }) { _ in
+            XCTFail("A superseded job must not deliver its result")
+        }
+        jobs.submit(target: "map", work: { _ -> Int in ran.append(2); return 2 }) { value in
+            XCTAssertEqual(value, 2)
+            delivered.fulfill()
+        }
+        queue.resume()
+
+        wait(for: [delivered], timeout: 5)
+        XCTAssertTrue(first.isCancelled)
+        XCTAssertEqual(ran, [2], "A job superseded before it started should never run")
+
+        // Kernels stop at their first check of a cancelled token
+        let token = CancellationToken()
+        token.cancel()
+        let solver = RabiMapSolver(system: NLevelSystem(energies: [0, 1e-20]), initialLevel: 0, targetLevel: 1)
+        let map = solver.solve(detunings: [0], rabiFrequencies: [1e12], duration: 1e-12, cancellation: token)
+        XCTAssertEqual(map.populations, [0], "A cancelled map should not solve any lanes")
+    }
+
+    func testRabiMapIsIdenticalAcrossVectorWidths() {
+        let system = NLevelSystem(energies: [0, 1e-20, 2.2e-20])
+        let solver = RabiMapSolver(system: system, initialLevel: 0, targetLevel: 1)
+        let resonance = 1e-20 / 1.054571817e-34
+        let detunings = (0..<13).map { 1e-3 * resonance * Double($0 - 6) / 6 }
+        let rabiFrequencies = (1...5).map { 1e-3 * resonance * Double($0) / 5 }
+        let duration = 2 * RabiMapSolver.rabiPeriod(rabiFrequency: 1e-3 * resonance)
+        defer { CPUFeatures.override = nil }
+
+        // 65 lanes leave a partial vector at every width
+        var maps = [[Double]]()
+        for level in CPUFeatures.VectorLevel.allCases {
+            CPUFeatures.override = CPUFeatures(vectorLevel: level)
+            maps.append(solver.solve(detunings: detunings, rabiFrequencies: rabiFrequencies, duration: duration)
+                .populations)
+        }
+
+        for map in maps.dropFirst() {
+            XCTAssertEqual(map, maps[0], "Every lane width should run the same arithmetic per lane")
+        }
+        XCTAssertGreaterThan(maps[0].max() ?? 0, 0.5, "The resonant drive should transfer population")
+    }
+
+    func testGridBuffersAreAlignedZeroedAndPooled() {
+        let pageSize = Int(getpagesize())
+        let count = 3 << 18  // 6 MB of doubles: superpage-sized and several zeroing tiles
+
+        var buffer: GridBuffer<Double>? = GridBuffer<Double>(count: count)
+        let address = buffer!.baseAddress
+        XCTAssertEqual(Int(bitPattern: address) % pageSize, 0, "Grid buffers should start on a page")
+        XCTAssertEqual(UnsafeBufferPointer(start: address, count: count).max(), 0)
+
+        address[count - 1] = 1
+        buffer = nil
+        let reused = GridBuffer<Double>(count: count)
+        XCTAssertEqual(reused.baseAddress, address, "A released block should be reused for the same size")
+        XCTAssertEqual(reused.baseAddress[count - 1], 0, "Reused blocks should be zeroed again")
+
+        let state = ComplexArray(count: count)
+        XCTAssertEqual(state.real.count, count)
+        XCTAssertEqual(state.squaredMagnitudeSum, 0)
+    }
+
+    func testGalileanFrameMatchesLabFrameAcrossBarrier() {
+        simulator.setPotentialHeight(9.5)
+        let lab = simulator.makeSplitOperatorPropagator(pointCount: 2048)
+        var psi = simulator.makeInitialState(on: lab.grid)
+        let frame = simulator.makeGalileanFramePropagator()
+        var state = simulator.makeGalileanFrameState(for: frame)
+        XCTAssertFalse(frame.aliasesReflections, "The factory should resolve the reflected wave")
+
+        let duration = 1.4e-14
+        lab.propagate(&psi, duration: duration, steps: 3000)
+        frame.propagate(&state, timeStep: duration / 3000, steps: 3000)
+
+        // The barrier spans 4–6 nm; the transmitted part stays in the window, the reflected part leaves it
+        let barrierEnd = 6e-9
+        let windowStart = state.frameOrigin + frame.grid.xMin
+        let labDensity = psi.probabilityDensity
+        let envelopeDensity = state.probabilityDensity
+        let labTransmitted = (0..<lab.grid.count).filter { lab.grid.position(at: $0) > barrierEnd }
+            .reduce(0) { $0 + labDensity[$1] } * lab.grid.dx
+        let labBehindWindow = (0..<lab.grid.count).filter { lab.grid.position(at: $0) < windowStart }
+            .reduce(0) { $0 + labDensity[$1] } * lab.grid.dx
+        let transmitted = (0..<frame.grid.count)
+            .filter { state.frameOrigin + frame.grid.position(at: $0) > barrierEnd }
+            .reduce(0) { $0 + envelopeDensity[$1] } * frame.grid.dx
+
+        XCTAssertGreaterThan(labTransmitted, 0.2)
+        XCTAssertEqual(transmitted, labTransmitted, accuracy: 5e-3, "Transmission should match the lab frame")
+        XCTAssertEqual(state.escapedNorm, labBehindWindow, accuracy: 2e-2,
+                       "Reflected density should be absorbed and reported, not wrapped")
+        XCTAssertEqual(state.envelope.norm(dx: frame.grid.dx) + state.escapedNorm, 1, accuracy: 1e-9)
+    }
+
+    func testMovingWindowAbsorbsAndReportsEscapingDensity() {
+        let grid = QuantumGrid(xMin: -20e-9, xMax: 20e-9, count: 8192)
+        let k = sqrt(2 * electronMass * 10 * 1.602176634e-19) / QuantumMath.reducedPlanckConstant
+        var psi = ComplexArray(count: grid.count)
+        for (i, x) in grid.positions.enumerated() {
+            let offset = (x + 10e-9) / 1e-9
+            psi[i] = exp(-offset * offset / 2) * Complex.fromPolar(r: 1, theta: k * x)
+        }
+        psi.normalize(dx: grid.dx)
+
+        let free = SplitOperatorPropagator(
+            grid: grid, mass: electronMass, potential: [Double](repeating: 0, count: grid.count))
+        var reference = psi
+        free.propagate(&reference, timeStep: 5e-18, steps: 1000)
+        let referenceDensity = reference.probabilityDensity
+        func labNorm(from x: Double) -> Double {
+            return (0..<grid.count).filter { grid.position(at: $0) >= x }.reduce(0) { $0 + referenceDensity[$1] }
+                * grid.dx
+        }
+
+        // Adapting every few steps follows the packet without losing anything measurable
+        let adaptive = MovingWindowPropagator(labGrid: grid, mass: electronMass, potential: free.potential)
+        var followed = adaptive.makeState(from: psi)
+        adaptive.propagate(&followed, timeStep: 5e-18, steps: 1000)
+        XCTAssertLessThan(
+            ComplexArray.distance(adaptive.reconstructWaveFunction(followed), reference) * sqrt(grid.dx), 1e-9)
+        XCTAssertLessThan(followed.lostNorm, 1e-9)
+
+        // Never adapting lets the packet run out of its first window; the edge must absorb it, not wrap it
+        var configuration = MovingWindowPropagator.Configuration()
+        configuration.adaptationInterval = 10_000
+        let fixed = MovingWindowPropagator(
+            labGrid: grid, mass: electronMass, potential: free.potential, configuration: configuration)
+        var state = fixed.makeState(from: psi)
+        let windowEnd = grid.position(at: state.startIndex + state.windowCount)
+        let layerStart = grid.position(at: state.startIndex + state.windowCount - state.marginCells)
+        fixed.propagate(&state, timeStep: 5e-18, steps: 1000)
+
+        XCTAssertEqual(state.window.norm(dx: grid.dx) + state.lostNorm, 1, accuracy: 1e-9,
+                       "Absorbed density should be counted in lostNorm")
+        XCTAssertGreaterThan(state.lostNorm, labNorm(from: windowEnd))
+        XCTAssertLessThan(state.lostNorm, labNorm(from: layerStart))
+        let trailing = fixed.reconstructWaveFunction(state).probabilityDensity[0..<(grid.count / 4)]
+        XCTAssertLessThan(trailing.max() ?? 0, 1e-4 * (referenceDensity.max() ?? 0),
+                          "Nothing should wrap around to the trailing edge")
+
+        // Exceeding the budget widens this run's margins only
+        XCTAssertGreaterThan(state.marginCells, configuration.marginCells)
+        XCTAssertEqual(fixed.makeState(from: psi).marginCells, configuration.marginCells)
+        XCTAssertEqual(fixed.configuration.normLossBudget, configuration.normLossBudget)
+    }
+
+    func testParityReducedPropagatorMatchesFullGrid() {
+        simulator.setSystemType(.harmonicOscillator)
+        simulator.setEnergyLevel(2)
+        guard let reduced = simulator.makeParityReducedPropagator(pointCount: 256) else {
+            return XCTFail("The oscillator should be mirror symmetric")
+        }
+        XCTAssertEqual(reduced.parity, .odd, "The first excited state should be detected as odd")
+
+        // The reduced grid is the right half of a symmetric periodic grid with the same spacing
+        let fullGrid = QuantumGrid.mirrorSymmetric(
+            center: reduced.center, halfWidth: reduced.grid.xMax - reduced.grid.xMin, count: 512)
+        let full = SplitOperatorPropagator(
+            grid: fullGrid, mass: electronMass, potential: fullGrid.positions.map { simulator.potentialEnergy(at: $0) })
+        var psi = simulator.makeInitialState(on: fullGrid)
+        var half = reduced.makeState(from: psi, on: fullGrid)
+
+        full.propagate(&psi, timeStep: 1e-15, steps: 1000)
+        reduced.propagate(&half, timeStep: 1e-15, steps: 1000)
+
+        let rebuilt = reduced.reconstructWaveFunction(half, on: fullGrid)
+        XCTAssertLessThan(ComplexArray.distance(rebuilt, psi) * sqrt(fullGrid.dx), 1e-9,
+                          "The odd sector should evolve exactly like the full grid")
+    }
+
+    func testMirrorReducedADIMatchesFullBox() {
+        // Odd along x, even along y, with a chirp so every mode moves
+        let halfWidth = 10e-9
+        let axes = [
+            QuantumGrid.mirrorReduced(center: 0, halfWidth: halfWidth, count: 32),
+            QuantumGrid.mirrorReduced(center: 0, halfWidth: halfWidth, count: 32),
+        ]
+        let potential: (Double, Double, Double) -> Double = { x, y, _ in 1e-20 * (x * x + 2 * y * y) / 1e-16 }
+        let state: (Double, Double, Double) -> Complex = { x, y, _ in
+            let r2 = (x * x + y * y) / 1e-17
+            return (x / 1e-9) * exp(-r2) * Complex.fromPolar(r: 1, theta: 0.3 * r2)
+        }
+
+        let reduced = ADIPropagator(axes: axes, parities: [.odd, .even], mass: electronMass, potential: potential)
+        let full = ADIPropagator(axes: reduced.fullAxes, mass: electronMass, potential: potential)
+        XCTAssertEqual(full.count, 4 * reduced.count)
+
+        var quarter = reduced.makeState(state)
+        var psi = full.makeState(state)
+        let initialMismatch = ComplexArray.distance(reduced.reconstructWaveFunction(quarter), psi)
+        XCTAssertLessThan(initialMismatch * sqrt(full.cellVolume), 1e-12)
+
+        reduced.propagate(&quarter, timeStep: 1e-15, steps: 40)
+        full.propagate(&psi, timeStep: 1e-15, steps: 40)
+
+        XCTAssertEqual(reduced.norm(of: quarter), 1, accuracy: 1e-10)
+        let mismatch = ComplexArray.distance(reduced.reconstructWaveFunction(quarter), psi)
+        XCTAssertLessThan(mismatch * sqrt(full.cellVolume), 1e-9,
+                          "The mirror ghost points should reproduce the full-box evolution")
+
+        // The factory detects the parities instead of assuming them
+        simulator.setSystemType(.harmonicOscillator)
+        simulator.setEnergyLevel(2)
+        let oscillator = simulator.makeMirrorReducedADIPropagator(dimensions: 3, pointsPerAxis: 8)
+        XCTAssertEqual(oscillator.parities, [.odd, .odd, .odd])
+        simulator.setSystemType(.freeParticle)
+        let packet = simulator.makeMirrorReducedADIPropagator(dimensions: 2, pointsPerAxis: 8)
+        XCTAssertEqual(packet.parities, [nil, .even], "The moving packet is only symmetric transversely")
+    }
+
+    func testADIFactorizesIntoOneDimensionalCrankNicolsonAndConservesNorm() {
+        let hBar = QuantumMath.reducedPlanckConstant
+        let dt = 1e-16
+        let steps = 200
+
+        // One Strang step of the 1D Crank–Nicolson scheme: half potential, Cayley factor, half potential
+        func crankNicolson1D(_ psi: inout ComplexArray, grid: QuantumGrid, potential: (Double) -> Double) {
+            let coupling = hBar * hBar / (2 * electronMass * grid.dx * grid.dx)
+            let step = CrankNicolsonStep(
+                weights: [Double](repeating: 1, count: grid.count),
+                diagonal: [Double](repeating: 2 * coupling, count: grid.count),
+                offDiagonal: [Double](repeating: -coupling, count: grid.count - 1),
+                tau: dt / (2 * hBar))
+            let halfPhase = grid.positions.map { Complex.fromPolar(r: 1, theta: -potential($0) * dt / (2 * hBar)) }
+            for _ in 0..<steps {
+                for i in 0..<grid.count { psi[i] = halfPhase[i] * psi[i] }
+                psi.withSplitComplex { state in
+                    step.apply(real: state.pointee.realp, imaginary: state.pointee.imagp)
+                }
+                for i in 0..<grid.count { psi[i] = halfPhase[i] * psi[i] }
+            }
+        }
+
+        // A separable potential and a product state: ADI must equal the product of 1D solutions
+        let axes = [
+            QuantumGrid(xMin: -10e-9, xMax: 10e-9, count: 64),
+            QuantumGrid(xMin: -8e-9, xMax: 8e-9, count: 40),
+            QuantumGrid(xMin: -6e-9, xMax: 6e-9, count: 24),
+        ]
+        let omega = 1.5e14
+        let potentials: [(Double) -> Double] = [
+            { 0.5 * self.electronMass * omega * omega * $0 * $0 },
+            { _ in 0 },
+            { 1.6e-20 * $0 / 1e-9 },
+        ]
+        let factors: [(Double) -> Complex] = [
+            { exp(-$0 * $0 / 2e-18) * Complex.fromPolar(r: 1, theta: 2e9 * $0) },
+            { exp(-$0 * $0 / 4.5e-18) },
+            { exp(-($0 - 1e-9) * ($0 - 1e-9) / 2e-18) * Complex.fromPolar(r: 1, theta: -1e9 * $0) },
+        ]
+
+        var lines = zip(axes, factors).map { grid, factor -> ComplexArray in
+            var line = ComplexArray(count: grid.count)
+            for i in 0..<grid.count { line[i] = factor(grid.position(at: i)) }
+            line.normalize(dx: grid.dx)
+            return line
+        }
+        for axis in 0..<3 {
+            crankNicolson1D(&lines[axis], grid: axes[axis], potential: potentials[axis])
+        }
+
+        for dimensions in [2, 3] {
+            let adi = ADIPropagator(axes: Array(axes.prefix(dimensions)), mass: electronMass) { x, y, z in
+                potentials[0](x) + potentials[1](y) + (dimensions == 3 ? potentials[2](z) : 0)
+            }
+            var psi = adi.makeState { x, y, z in
+                factors[0](x) * factors[1](y) * (dimensions == 3 ? factors[2](z) : Complex(real: 1))
+            }
+            adi.propagate(&psi, timeStep: dt, steps: steps)
+
+            var product = ComplexArray(count: adi.count)
+            let nz = dimensions == 3 ? axes[2].count : 1
+            for k in 0..<nz {
+                let zFactor = dimensions == 3 ? lines[2][k] : Complex(real: 1)
+                for j in 0..<axes[1].count {
+                    for i in 0..<axes[0].count {
+                        product[(k * axes[1].count + j) * axes[0].count + i] = lines[0][i] * lines[1][j] * zFactor
+                    }
+                }
+            }
+            XCTAssertLessThan(ComplexArray.distance(psi, product) * sqrt(adi.cellVolume), 1e-10,
+                              "\(dimensions)D ADI should factorize into 1D Crank–Nicolson steps")
+        }
+
+        // A coupled potential and a step far beyond the explicit limit still keep the norm
+        for dimensions in [2, 3] {
+            let adi = ADIPropagator(axes: Array(axes.prefix(dimensions)), mass: electronMass) { x, y, z in
+                1e-20 * (x * y + y * z) / 1e-18 + (abs(x - 3e-9) < 5e-10 ? 3e-19 : 0)
+            }
+            var psi = adi.makeState { x, y, z in
+                exp(-(x * x + 2 * y * y + z * z) / 4e-18) * Complex.fromPolar(r: 1, theta: 3e9 * x)
+            }
+            adi.propagate(&psi, timeStep: 2e-15, steps: 100)
+            XCTAssertEqual(adi.norm(of: psi), 1, accuracy: 1e-10, "\(dimensions)D ADI should be unitary")
+        }
+    }
+
+    func testVisscherConservesNormAndRespectsStabilityBound() {
+        let grid = QuantumGrid(xMin: -10e-9, xMax: 10e-9, count: 512)
+        let omega = 1.5e14
+        let potential = grid.positions.map { 0.5 * electronMass * omega * omega * $0 * $0 }
+        let propagator = VisscherPropagator(grid: grid, mass: electronMass, potential: potential)
+
+        var packet = ComplexArray(count: grid.count)
+        for (i, x) in grid.positions.enumerated() {
+            packet[i] = exp(-(x + 2e-9) * (x + 2e-9) / 2e-18) * Complex.fromPolar(r: 1, theta: 3e9 * x)
+        }
+        packet.normalize(dx: grid.dx)
+
+        // At the safe step the synchronized norm only wanders by O(dt²)
+        let dt = propagator.stableTimeStep
+        var psi = packet
+        propagator.propagate(&psi, timeStep: dt, steps: 3000)
+        XCTAssertEqual(psi.norm(dx: grid.dx), 1, accuracy: 1e-5, "Visscher stepping should keep the norm")
+
+        // Second order: halving dt cuts the error against a dt/4 reference by about 5×
+        var coarse = packet
+        var medium = packet
+        var fine = packet
+        propagator.propagate(&coarse, timeStep: dt, steps: 1000)
+        propagator.propagate(&medium, timeStep: dt / 2, steps: 2000)
+        propagator.propagate(&fine, timeStep: dt / 4, steps: 4000)
+        let ratio = ComplexArray.distance(coarse, fine) / ComplexArray.distance(medium, fine)
+        XCTAssertEqual(ratio, 5, accuracy: 0.2, "Visscher stepping should converge at second order")
+
+        // The bound is sharp: seed the highest mode and step just inside and just outside it
+        let limit = propagator.stableTimeStep / 0.9
+        var seeded = packet
+        for i in 0..<grid.count {
+            seeded.real[i] += i % 2 == 0 ? 1e-8 : -1e-8
+        }
+        var inside = seeded
+        var outside = seeded
+        propagator.propagate(&inside, timeStep: 0.99 * limit, steps: 300)
+        propagator.propagate(&outside, timeStep: 1.05 * limit, steps: 300)
+        XCTAssertEqual(inside.norm(dx: grid.dx), 1, accuracy: 1e-6, "Steps below the bound should stay bounded")
+        XCTAssertGreaterThan(outside.norm(dx: grid.dx), 1e6, "Steps above the bound should blow up")
+    }
+
+    func testQuantumKernelParametersMatchShaderLayout() {
+        // ShaderTypes.h: eight 4-byte fields, gridSize, padding, an 8-byte aligned float2, hbar and mass
+        XCTAssertEqual(MemoryLayout<QuantumKernelParameters>.stride, 56)
+        XCTAssertEqual(MemoryLayout<QuantumKernelParameters>.offset(of: \.gridSize), 32)
+        XCTAssertEqual(MemoryLayout<QuantumKernelParameters>.offset(of: \.domain), 40)
+        XCTAssertEqual(MemoryLayout<QuantumKernelParameters>.offset(of: \.hbar), 48)
+        XCTAssertEqual(MemoryLayout<QuantumKernelParameters>.offset(of: \.mass), 52)
+    }
+
+    func testGPUStableTimeStepSurvivesSIUnitsInFloat() {
+        // The renderer's parameters: an electron on ±10 nm with 512 points, where ħ² underflows Float
+        let parameters = QuantumKernelParameters(
+            gridSize: 512, domain: SIMD2<Float>(-10e-9, 10e-9), hbar: 1.054571817e-34, mass: 9.1093837e-31)
+        let gpuStep = Double(QuantumEvolutionKernel.stableTimeStep(parameters: parameters, maxPotential: 0))
+        let cpuStep = VisscherPropagator.stableTimeStep(dx: 20e-9 / 512, mass: 9.1093837e-31, maxPotential: 0)
+
+        XCTAssertTrue(gpuStep.isFinite, "The kinetic bound must not underflow to zero")
+        XCTAssertGreaterThan(gpuStep, 0.999 * cpuStep)
+        XCTAssertLessThanOrEqual(gpuStep, cpuStep * (1 + 1e-6), "The GPU step must stay within the stability bound")
+    }
+
+    func testDrivenOscillatorFollowsClassicalOrbitAtFourthOrder() {
+        // Dipole-driven oscillator: ⟨x⟩ obeys the classical forced equation exactly (Ehrenfest)
+        let grid = QuantumGrid(xMin: -15e-9, xMax: 15e-9, count: 256)
+        let charge = 1.602176634e-19
+        let omega = 1.5e14
+        let driveFrequency = 0.7 * omega
+        let field = 1.3e8
+        let potential = DrivenPotential(
+            staticPart: grid.positions.map { 0.5 * electronMass * omega * omega * $0 * $0 },
+            terms: [DrivenPotential.Term(
+                profile: grid.positions.map { charge * $0 },
+                amplitude: DrivenPotential.sinusoidal(amplitude: field, angularFrequency: driveFrequency))])
+        let propagator = DrivenPropagator(grid: grid, mass: electronMass, potential: potential)
+        let exponentialMidpoint = DrivenPropagator(
+            grid: grid, mass: electronMass, potential: potential, scheme: .exponentialMidpoint)
+
+        // Oscillator ground state, at rest at the origin when the drive starts
+        let width = sqrt(QuantumMath.reducedPlanckConstant / (electronMass * omega))
+        var groundState = ComplexArray(count: grid.count)
+        for (i, x) in grid.positions.enumerated() {
+            groundState[i] = Complex(real: exp(-x * x / (2 * width * width)))
+        }
+        groundState.normalize(dx: grid.dx)
+
+        let duration = 1e-13
+        func evolve(_ engine: DrivenPropagator, steps: Int) -> ComplexArray {
+            var psi = groundState
+            engine.propagate(&psi, from: 0, timeStep: duration / Double(steps), steps: steps)
+            return psi
+        }
+
+        let psi = evolve(propagator, steps: 200)
+        let meanPosition = zip(psi.probabilityDensity, grid.positions).reduce(0) { $0 + $1.0 * $1.1 } * grid.dx
+        let amplitude = charge * field / (electronMass * (omega * omega - driveFrequency * driveFrequency))
+        let classical = -amplitude * (sin(driveFrequency * duration)
+            - driveFrequency / omega * sin(omega * duration))
+        XCTAssertEqual(psi.norm(dx: grid.dx), 1, accuracy: 1e-12)
+        XCTAssertEqual(meanPosition, classical, accuracy: 1e-13, "⟨x⟩ should follow the forced classical orbit")
+
+        // Halving dt cuts the error 16× for CF4 and 4× for the exponential midpoint rule
+        let reference = evolve(propagator, steps: 800)
+        let cf4Ratio = ComplexArray.distance(evolve(propagator, steps: 50), reference)
+            / ComplexArray.distance(evolve(propagator, steps: 100), reference)
+        let midpointRatio = ComplexArray.distance(evolve(exponentialMidpoint, steps: 200), reference)
+            / ComplexArray.distance(evolve(exponentialMidpoint, steps: 400), reference)
+        XCTAssertEqual(cf4Ratio, 16, accuracy: 1.5, "Commutator-free Magnus should converge at fourth order")
+        XCTAssertEqual(midpointRatio, 4, accuracy: 0.3, "The exponential midpoint rule should be second order")
+    }
+
+    func testSpinPrecessesAtLarmorAndSpinOrbitFrequencies() {
+        let hBar = QuantumMath.reducedPlanckConstant
+
+        // A uniform 1 T field along z turns spin +x about z at ω_L = 2μ_B B/ħ (g = 2)
+        let propagator = simulator.makeSpinorPropagator(pointsPerAxis: 256, magneticField: SIMD3(0, 0, 1))
+        var psi = simulator.makeSpinorState(for: propagator)
+        let bohrMagneton = 1.602176634e-19 * hBar / (2 * electronMass)
+        let larmor = 2 * bohrMagneton / hBar
+        let dt = 1e-13
+        propagator.propagate(&psi, timeStep: dt, steps: 200)
+
+        let spin = propagator.spinExpectation(psi)
+        let angle = larmor * 200 * dt
+        XCTAssertEqual(spin.x, cos(angle), accuracy: 1e-9, "Spin should precess at the Larmor frequency")
+        XCTAssertEqual(spin.y, sin(angle), accuracy: 1e-9)
+        XCTAssertEqual(spin.z, 0, accuracy: 1e-9)
+
+        // Rashba coupling on a plane wave e^{ikx}: H_SO = -αkσy splits the band by 2αk,
+        // so spin +z turns about y at 2αk/ħ
+        let grid = QuantumGrid(xMin: -10e-9, xMax: 10e-9, count: 64)
+        let rashba = 1e-30
+        let waveNumber = grid.waveNumbers[5]
+        let spinOrbit = SpinorPropagator(
+            axes: [grid], mass: electronMass, potential: [Double](repeating: 0, count: grid.count),
+            zeemanField: [SIMD3<Double>](repeating: .zero, count: grid.count),
+            spinOrbit: SpinorPropagator.SpinOrbitCoupling(rashba: rashba))
+
+        var planeWave = ComplexArray(count: grid.count)
+        for (i, x) in grid.positions.enumerated() {
+            planeWave[i] = Complex.fromPolar(r: 1, theta: waveNumber * x)
+        }
+        var spinor = SpinorArray(up: planeWave, down: ComplexArray(count: grid.count))
+        spinor.normalize(cellVolume: grid.dx)
+        spinOrbit.propagate(&spinor, timeStep: 2e-15, steps: 50)
+
+        let splitting = 2 * rashba * waveNumber / hBar * 50 * 2e-15
+        let polarization = spinOrbit.spinExpectation(spinor)
+        XCTAssertEqual(polarization.z, cos(splitting), accuracy: 1e-9,
+                       "Spin should precess at the spin-orbit splitting")
+        XCTAssertEqual(polarization.x, -sin(splitting), accuracy: 1e-9)
+        XCTAssertEqual(polarization.y, 0, accuracy: 1e-9)
+    }
+
+    func testDiracPacketShowsZitterbewegungOnlyWithMixedEnergies() {
+        let hBar = QuantumMath.reducedPlanckConstant
+        let grid = QuantumGrid(xMin: -10e-9, xMax: 10e-9, count: 1024)
+        let compton = 5e-11
+        let propagator = DiracPropagator(
+            grid: grid, mass: electronMass, potential: [Double](repeating: 0, count: grid.count),
+            speedOfLight: hBar / (electronMass * compton))
+        let c = propagator.speedOfLight
+        let restEnergy = propagator.restEnergy
+        XCTAssertEqual(propagator.comptonWavelength, compton, accuracy: 1e-24)
+
+        // Upper component only at ħk₀ = mc: equal parts of both energy signs
+        var upper = ComplexArray(count: grid.count)
+        for (i, x) in grid.positions.enumerated() {
+            let offset = x + 3e-9
+            upper[i] = exp(-offset * offset / 2e-18) * Complex.fromPolar(r: 1, theta: x / compton)
+        }
+        upper.normalize(dx: grid.dx)
+        var psi = SpinorArray(up: upper, down: ComplexArray(count: grid.count))
+
+        // Exact free evolution: d⟨x⟩/dt = c⟨σx⟩, and for spin up at wave number k
+        // ⟨σx⟩ = sinθ cosθ (1 - cos ω_k t) with tanθ = ħk/mc and ω_k = 2E_k/ħ
+        var spectrum = upper
+        let fft = FFTPlan(count: grid.count)
+        spectrum.withSplitComplex { fft.forward($0) }
+        let total = spectrum.squaredMagnitudeSum
+        let weights = spectrum.probabilityDensity.map { $0 / total }
+        let modes = grid.waveNumbers.map { k -> (drift: Double, omega: Double) in
+            let momentumEnergy = c * hBar * k
+            let energy = (momentumEnergy * momentumEnergy + restEnergy * restEnergy).squareRoot()
+            return (c * momentumEnergy * restEnergy / (energy * energy), 2 * energy / hBar)
+        }
+        func predictedShift(at t: Double) -> (total: Double, trembling: Double) {
+            var drift = 0.0
+            var trembling = 0.0
+            for (weight, mode) in zip(weights, modes) {
+                drift += weight * mode.drift * t
+                trembling -= weight * mode.drift * sin(mode.omega * t) / mode.omega
+            }
+            return (drift + trembling, trembling)
+        }
+
+        let start = propagator.expectationPosition(psi)
+        var largestTrembling = 0.0
+        for chunk in 1...8 {
+            propagator.propagate(&psi, timeStep: 1e-18, steps: 25)
+            let predicted = predictedShift(at: Double(chunk) * 25e-18)
+            largestTrembling = max(largestTrembling, abs(predicted.trembling))
+            XCTAssertEqual(propagator.expectationPosition(psi) - start, predicted.total, accuracy: 1e-6 * compton,
+                           "⟨x⟩ should follow the exact Zitterbewegung trajectory")
+        }
+        // The trembling amplitude is of order ħ/mc (λ_C / 4√2 for a single mode at θ = 45°)
+        XCTAssertGreaterThan(largestTrembling, 0.1 * compton)
+
+        // A positive-energy packet drifts at its group velocity without trembling
+        var positive = propagator.makePositiveEnergyPacket(center: -3e-9, width: 1e-9, waveNumber: 1 / compton)
+        var positions = [propagator.expectationPosition(positive)]
+        for _ in 0..<2 {
+            propagator.propagate(&positive, timeStep: 1e-18, steps: 37)
+            positions.append(propagator.expectationPosition(positive))
+        }
+        XCTAssertEqual(positions[1] - positions[0], positions[2] - positions[1], accuracy: 1e-6 * compton,
+                       "Positive-energy packets should move uniformly")
+    }
+
+    func testTwoParticleBoxMatchesProductStatesAndKeepsExchangeSymmetry() {
+        let hBar = QuantumMath.reducedPlanckConstant
+        simulator.setSystemType(.potentialWell)
+
+        // The box grid puts the Dirichlet walls on the well edges
+        let propagator = simulator.makeTwoParticlePropagator(
+            pointCount: 64, symmetry: .fermionic, interactionStrength: 0)
+        let grid = propagator.grid
+        let n = grid.count
+        XCTAssertEqual(grid.xMin - grid.dx, -10e-9, accuracy: 1e-18)
+        XCTAssertEqual(grid.xMax, 10e-9, accuracy: 1e-18)
+
+        func packet(center: Double, waveNumber: Double) -> ComplexArray {
+            var orbital = ComplexArray(count: n)
+            for (j, x) in grid.positions.enumerated() {
+                let offset = x - center
+                orbital[j] = exp(-offset * offset / 4.5e-18) * Complex.fromPolar(r: 1, theta: waveNumber * x)
+            }
+            return orbital
+        }
+        let left = packet(center: -4e-9, waveNumber: 1e9)
+        let right = packet(center: 4e-9, waveNumber: -1e9)
+
+        // Exact evolution of one orbital in the discrete box: sine modes with E_m = 2c(1 - cos(mπ/(N+1)))
+        let coupling = hBar * hBar / (2 * electronMass * grid.dx * grid.dx)
+        func evolveExactly(_ orbital: ComplexArray, for time: Double) -> ComplexArray {
+            var result = ComplexArray(count: n)
+            for mode in 1...n {
+                let shape = (0..<n).map { sin(Double(mode * ($0 + 1)) * Double.pi / Double(n + 1)) }
+                var overlap = Complex()
+                for j in 0..<n {
+                    overlap = overlap + shape[j] * orbital[j]
+                }
+                let energy = 2 * coupling * (1 - cos(Double(mode) * Double.pi / Double(n + 1)))
+                let amplitude = (2 / Double(n + 1)) * (Complex.fromPolar(r: 1, theta: -energy * time / hBar) * overlap)
+                for j in 0..<n {
+                    result[j] = result[j] + shape[j] * amplitude
+                }
+            }
+            return result
+        }
+
+        // Without interaction the pair stays the (anti)symmetrized product of the evolved orbitals
+        let duration = 4e-14
+        let steps = Int((duration / (0.1 * propagator.stableTimeStep)).rounded(.up))
+        for symmetry in [ExchangeSymmetry.fermionic, .bosonic] {
+            let free = simulator.makeTwoParticlePropagator(pointCount: 64, symmetry: symmetry, interactionStrength: 0)
+            var state = free.makeState(first: left, second: right)
+            free.propagate(&state, timeStep: duration / Double(steps), steps: steps)
+
+            let expected = free.makeState(
+                first: evolveExactly(left, for: duration), second: evolveExactly(right, for: duration))
+            var squaredError = 0.0
+            for i in 0..<n {
+                for j in 0..<n {
+                    squaredError += (state[i, j] - expected[i, j]).absoluteSquared * grid.dx * grid.dx
+                }
+            }
+            XCTAssertLessThan(sqrt(squaredError), 1e-4, "Non-interacting pairs should stay product states")
+        }
+
+        // With repulsion the fermionic diagonal stays empty and the returned density is the reduced one
+        let interacting = simulator.makeTwoParticlePropagator(pointCount: 64, symmetry: .fermionic)
+        var pair = interacting.makeState(first: left, second: right)
+        let density = interacting.propagate(&pair, timeStep: interacting.stableTimeStep, steps: 500)
+        let largest = (0..<n).flatMap { i in (i..<n).map { pair[i, $0].magnitude } }.max()!
+        let diagonal = (0..<n).map { pair[$0, $0].magnitude }.max()!
+        XCTAssertLessThan(diagonal, 1e-12 * largest, "Two fermions must never share a site")
+        XCTAssertEqual(interacting.norm(of: pair), 1, accuracy: 1e-3)
+        for (returned, reduced) in zip(density, interacting.oneBodyDensity(pair)) {
+            XCTAssertEqual(returned, reduced, accuracy: 1e-9 * largest * largest * grid.dx)
+        }
+    }
+
+    func testBarrierTransmissionMatchesSquareBarrierAndConservesFlux() {
+        // Without a barrier the whole packet is transmitted
+        let free = simulator.measureTransmission()
+        XCTAssertEqual(free.transmission, 1, accuracy: 1e-3, "A free packet should be fully transmitted")
+        XCTAssertEqual(free.reflection, 0, accuracy: 1e-6, "A free packet should not be reflected")
+
+        // 10 eV packet over a 5 eV, 2 nm barrier
+        let height = 5.0
+        simulator.setPotentialHeight(height)
+        let measured = simulator.measureTransmission()
+        XCTAssertEqual(measured.transmission + measured.reflection, 1, accuracy: 1e-3,
+                       "Transmitted and reflected probability should add up to the packet")
+
+        // Square-barrier T(E) = 1 / (1 + V² sin²(qd) / (4E(E − V))), averaged over the packet's
+        // momentum density |φ(k)|² ∝ exp(−σ²(k − k0)²); every weighted k lies above the barrier
+        let hbar = QuantumMath.reducedPlanckConstant
+        let charge = 1.602176634e-19
+        let barrier = height * charge
+        let width = 40e-9 * 0.05
+        let sigma = 40e-9 * 0.05
+        let k0 = sqrt(2 * electronMass * 10 * charge) / hbar
+        var weightedTransmission = 0.0
+        var totalWeight = 0.0
+        for i in -600...600 {
+            let k = k0 + Double(i) / 100 / sigma
+            let energy = hbar * hbar * k * k / (2 * electronMass)
+            let q = sqrt(2 * electronMass * (energy - barrier)) / hbar
+            let transmission = 1 / (1 + barrier * barrier * pow(sin(q * width), 2) / (4 * energy * (energy - barrier)))
+            let weight = exp(-sigma * sigma * (k - k0) * (k - k0))
+            weightedTransmission += weight * transmission
+            totalWeight += weight
+        }
+        XCTAssertEqual(measured.transmission, weightedTransmission / totalWeight, accuracy: 0.01,
+                       "Transmission should match the packet-averaged square-barrier result")
+    }
+
+    func testRenderSchedulerIdlesAfterThresholdAndResumesOnInvalidate() {
+        let scheduler = RenderScheduler()
+        scheduler.idleFrameThreshold = 3
+        let activeLoops = PerformanceMonitor.shared.activeRenderLoops
+
+        // XCTest runs on the main thread, so invalidate() applies at once
+        scheduler.invalidate()
+        XCTAssertFalse(scheduler.isIdle)
+        XCTAssertEqual(PerformanceMonitor.shared.activeRenderLoops, activeLoops + 1)
+        XCTAssertTrue(scheduler.beginFrame(), "The frame carrying the change should be drawn")
+
+        // Unchanged frames keep drawing until the threshold-th one, which pauses the loop
+        XCTAssertTrue(scheduler.beginFrame())
+        XCTAssertTrue(scheduler.beginFrame())
+        XCTAssertFalse(scheduler.isIdle)
+        XCTAssertFalse(scheduler.beginFrame(), "The threshold-th unchanged frame should be skipped")
+        XCTAssertTrue(scheduler.isIdle)
+        XCTAssertEqual(PerformanceMonitor.shared.activeRenderLoops, activeLoops)
+        for _ in 0..<5 {
+            XCTAssertFalse(scheduler.beginFrame(), "An idle scheduler should skip frames")
+        }
+
+        // A change resumes drawing and restarts the count
+        scheduler.invalidate()
+        XCTAssertFalse(scheduler.isIdle)
+        XCTAssertEqual(PerformanceMonitor.shared.activeRenderLoops, activeLoops + 1)
+        XCTAssertTrue(scheduler.beginFrame())
+        XCTAssertTrue(scheduler.beginFrame())
+        XCTAssertTrue(scheduler.beginFrame())
+        XCTAssertFalse(scheduler.beginFrame())
+        XCTAssertTrue(scheduler.isIdle)
+    }
+
+    func testWorkerPoolRunsNestedLoopsFromJobs() {
+        let pool = WorkerPool(threadCount: 3)
+        let done = expectation(description: "jobs finished")
+        done.expectedFulfillmentCount = 6
+        let lock = NSLock()
+        var visits = [Int](repeating: 0, count: 6 * 8 * 16)
+
+        // More jobs than threads, each nesting two loops, so callers often finish loops alone
+        for job in 0..<6 {
+            pool.async {
+                pool.concurrentPerform(iterations: 8) { outer in
+                    pool.concurrentPerform(iterations: 16) { inner in
+                        lock.lock()
+                        visits[(job * 8 + outer) * 16 + inner] += 1
+                        lock.unlock()
+                    }
+                }
+                done.fulfill()
+            }
+        }
+
+        wait(for: [done], timeout: 10)
+        XCTAssertEqual(visits, [Int](repeating: 1, count: visits.count), "Every iteration should run exactly once")
+    }
+
+    static var allTests = [
+        ("testSplitOperatorConservesNorm", testSplitOperatorConservesNorm),
+        ("testCancelledPropagationEndsOnACompleteStep", testCancelledPropagationEndsOnACompleteStep),
+        ("testPararealMatchesSerialFineSolution", testPararealMatchesSerialFineSolution),
+        ("testRadialPropagatorKeepsHydrogenGroundStateStationary",
+         testRadialPropagatorKeepsHydrogenGroundStateStationary),
+        ("testAxisymmetricOscillatorStatesStayStationaryAndFillTheVolume",
+         testAxisymmetricOscillatorStatesStayStationaryAndFillTheVolume),
+        ("testBlochSolverReproducesFreeLatticeDispersion", testBlochSolverReproducesFreeLatticeDispersion),
+        ("testLindbladDephasingMatchesAnalyticCoherenceDecay", testLindbladDephasingMatchesAnalyticCoherenceDecay),
+        ("testQuantumJumpEnsembleIsReproducibleAcrossWorkerCounts",
+         testQuantumJumpEnsembleIsReproducibleAcrossWorkerCounts),
+        ("testRabiMapMatchesTwoLevelFormula", testRabiMapMatchesTwoLevelFormula),
+        ("testPlaneWaveCurrentAndDetectorFlux", testPlaneWaveCurrentAndDetectorFlux),
+        ("testPhaseFieldUnwrapsAcrossChunks", testPhaseFieldUnwrapsAcrossChunks),
+        ("testOptimalControlGradientMatchesFiniteDifferences", testOptimalControlGradientMatchesFiniteDifferences),
+        ("testEventTimesAreRefinedWithinSteps", testEventTimesAreRefinedWithinSteps),
+        ("testQuantumFrameViewsShareOneSnapshot", testQuantumFrameViewsShareOneSnapshot),
+        ("testNewerJobsSupersedeOlderOnes", testNewerJobsSupersedeOlderOnes),
+        ("testRabiMapIsIdenticalAcrossVectorWidths", testRabiMapIsIdenticalAcrossVectorWidths),
+        ("testGridBuffersAreAlignedZeroedAndPooled", testGridBuffersAreAlignedZeroedAndPooled),
+        ("testGalileanFrameMatchesLabFrameAcrossBarrier", testGalileanFrameMatchesLabFrameAcrossBarrier),
+        ("testMovingWindowAbsorbsAndReportsEscapingDensity", testMovingWindowAbsorbsAndReportsEscapingDensity),
+        ("testParityReducedPropagatorMatchesFullGrid", testParityReducedPropagatorMatchesFullGrid),
+        ("testMirrorReducedADIMatchesFullBox", testMirrorReducedADIMatchesFullBox),
+        ("testADIFactorizesIntoOneDimensionalCrankNicolsonAndConservesNorm",
+         testADIFactorizesIntoOneDimensionalCrankNicolsonAndConservesNorm),
+        ("testVisscherConservesNormAndRespectsStabilityBound", testVisscherConservesNormAndRespectsStabilityBound),
+        ("testQuantumKernelParametersMatchShaderLayout", testQuantumKernelParametersMatchShaderLayout),
+        ("testGPUStableTimeStepSurvivesSIUnitsInFloat", testGPUStableTimeStepSurvivesSIUnitsInFloat),
+        ("testDrivenOscillatorFollowsClassicalOrbitAtFourthOrder",
+         testDrivenOscillatorFollowsClassicalOrbitAtFourthOrder),
+        ("testSpinPrecessesAtLarmorAndSpinOrbitFrequencies", testSpinPrecessesAtLarmorAndSpinOrbitFrequencies),
+        ("testDiracPacketShowsZitterbewegungOnlyWithMixedEnergies",
+         testDiracPacketShowsZitterbewegungOnlyWithMixedEnergies),
+        ("testTwoParticleBoxMatchesProductStatesAndKeepsExchangeSymmetry",
+         testTwoParticleBoxMatchesProductStatesAndKeepsExchangeSymmetry),
+        ("testBarrierTransmissionMatchesSquareBarrierAndConservesFlux",
+         testBarrierTransmissionMatchesSquareBarrierAndConservesFlux),
+        ("testRenderSchedulerIdlesAfterThresholdAndResumesOnInvalidate",
+         testRenderSchedulerIdlesAfterThresholdAndResumesOnInvalidate),
+        ("testWorkerPoolRunsNestedLoopsFromJobs", testWorkerPoolRunsNestedLoopsFromJobs)
+    ]
+}